@@ -1,46 +1,86 @@
 #include "apps/CommandHandler/command_handler.hpp"
+#include "apps/StateMachine/state_machine.hpp"
 #include "queues/queues.hpp"
 #include "os/rtos.hpp"
 
-#include <iostream>
+#include <atomic>
 
-static bool g_armed = false;
-static bool g_tx_on = false;
+static std::atomic<uint32_t> g_dropped_acks{0};   // Written by the task, read from any
+
+static Rtos::EventGroup g_ready;
+static constexpr uint32_t SUBSCRIBED_BIT = 0x1;
+
+//== Built-in commands ==//
+// Arming and transmitter state belong to the StateMachine; its transition
+// table decides whether a command is allowed in the current phase.
+
+static bool OnNop(const msg::cmd&) { return true; }
+
+static bool OnArm(const msg::cmd&) { return StateMachine::Post(StateMachine::CMD_ARM); }
+static bool OnDisarm(const msg::cmd&) { return StateMachine::Post(StateMachine::CMD_DISARM); }
+static bool OnTxOn(const msg::cmd&) { return StateMachine::Post(StateMachine::CMD_TX_ON); }
+static bool OnTxOff(const msg::cmd&) { return StateMachine::Post(StateMachine::CMD_TX_OFF); }
+
+//== Dispatch table ==//
+
+struct Entry {
+    CommandHandler::Handler handler;
+    CommandHandler::Precondition pre;
+};
+
+// Indexed by msg::cmd::Type, so dispatch is a bounds check and one load
+static Entry g_table[msg::cmd::NUM_TYPES] = {
+    /* NOP    */ {OnNop, nullptr},
+    /* ARM    */ {OnArm, nullptr},
+    /* TX_ON  */ {OnTxOn, nullptr},
+    /* TX_OFF */ {OnTxOff, nullptr},
+    /* DISARM */ {OnDisarm, nullptr},
+};
+
+bool CommandHandler::Register(msg::cmd::Type type, Handler handler, Precondition pre) {
+    if (type < 0 || type >= msg::cmd::NUM_TYPES) return false;
+    g_table[type] = Entry{handler, pre};
+    return true;
+}
+
+msg::cmd_ack::Result CommandHandler::Dispatch(const msg::cmd& c) {
+    msg::cmd_ack::Result result = msg::cmd_ack::UNKNOWN;
+
+    if (c.type >= 0 && c.type < msg::cmd::NUM_TYPES && g_table[c.type].handler) {
+        const Entry& e = g_table[c.type];
+        bool ok = (!e.pre || e.pre()) && e.handler(c);
+        result = ok ? msg::cmd_ack::ACCEPTED : msg::cmd_ack::REJECTED;
+    }
+
+    // Never block the command path on a slow ack consumer
+    if (!Bus::Publish<Topics::CMD_ACK>(msg::cmd_ack{result, c.type, c.arg, c.ms})) {
+        g_dropped_acks.fetch_add(1, std::memory_order_relaxed);
+    }
+    return result;
+}
+
+uint32_t CommandHandler::DroppedAcks() {
+    return g_dropped_acks.load(std::memory_order_relaxed);
+}
+
+bool CommandHandler::WaitSubscribed(int timeout_ms) {
+    return (g_ready.wait(SUBSCRIBED_BIT, false, false, timeout_ms) & SUBSCRIBED_BIT) != 0;
+}
 
 void CommandHandler::Run(void*) {
-    std::cout << "CommandHandler ready (NOP | ARM | TX_ON | TX_OFF)\n";
     msg::cmd c{};
+    Bus::Subscription<Topics::CMD> cmds(Bus::Overflow::BACKPRESSURE);  // Commands are never dropped silently
+    g_ready.set(SUBSCRIBED_BIT);
 
     while(true) {
         
         // Wait forever for a command
-        if (!CmdQueue.receive(c, Rtos::MAX_TIMEOUT)) continue;
-
-        switch (c.type) {
-            case msg::cmd::NOP:
-                std::cout << "CMD: NOP\n";
-                break;
-
-            case msg::cmd::ARM:
-                g_armed = true;
-                std::cout << "CMD: ARM -> armed=1\n";
-                break;
-
-            case msg::cmd::TX_ON:
-                if (g_armed) {
-                    g_tx_on = true;
-                    std::cout << "CMD: TX_ON -> tx=1\n";
-                } else {
-                    std::cout << "WARN: TX_ON ignored (not armed)\n";
-                }
-                break;
-
-            case msg::cmd::TX_OFF:
-                g_tx_on = false;
-                std::cout << "CMD: TX_OFF -> tx=0\n";
-                break;
+        if (!cmds.receive(c, Rtos::MAX_TIMEOUT)) continue;
+        Dispatch(c);
+
+        // Then handle the rest of a burst without going back to sleep
+        while (cmds.try_receive(c)) {
+            Dispatch(c);
         }
-        
-        Rtos::SleepMs(1);
     }
-}
\ No newline at end of file
+}
@@ -1,7 +1,32 @@
 #pragma once
 #include <cstdint>
+#include "msg/messages.hpp"
+#include "os/rtos.hpp"
 
+// Table-driven command dispatch
+//
+// Each command type maps to a handler plus an optional precondition
+// (e.g. "armed required"). New commands are added with Register() instead
+// of editing a switch. Every command produces a msg::cmd_ack on the CMD_ACK topic.
 class CommandHandler {
     public:
+        using Handler = bool (*)(const msg::cmd& c);  // false: rejected
+        using Precondition = bool (*)();              // false: rejected, handler not run
+
+        // Install (or replace) the entry for a command type.
+        // Call before the CommandHandler task is started.
+        static bool Register(msg::cmd::Type type, Handler handler, Precondition pre = nullptr);
+
+        // Execute one command through the table and post its ack
+        static msg::cmd_ack::Result Dispatch(const msg::cmd& c);
+
+        // Acks that could not be published because the CMD_ACK topic was full
+        static uint32_t DroppedAcks();
+
+        // Blocks until the task has subscribed to the CMD topic; call after
+        // creating it, before starting command producers (uplink), since a
+        // command published with no subscriber is lost. false on timeout.
+        static bool WaitSubscribed(int timeout_ms = Rtos::MAX_TIMEOUT);
+
         static void Run(void* args); //Rtos task entry point
-};
\ No newline at end of file
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include "utils/matrix.hpp"
+
+// Minimal extended Kalman filter core
+//
+// The model-specific parts (state propagation and Jacobians) live in the
+// caller; this only keeps x and P and applies the covariance algebra.
+// Measurements are processed one scalar at a time, so the innovation
+// covariance is a number and no matrix inverse is ever needed.
+template <size_t N>
+class Ekf {
+    public:
+        using Vec = Linalg::Vector<N>;
+        using Mat = Linalg::Matrix<N, N>;
+
+        Vec x = Vec::Zero();
+        Mat P = Mat::Identity();
+
+        // P = F P F^T + Q, after the caller has propagated x
+        void Predict(const Mat& F, const Mat& Q) {
+            P = Linalg::Congruence(F, P);
+            P += Q;
+        }
+
+        // Scalar update: z - h(x) = residual, H the measurement row.
+        // Returns false (and changes nothing) if the normalised innovation
+        // exceeds gate^2, so outliers cannot drag the state around.
+        bool Update(const Vec& H, float residual, float R, float gate = 0.0f) {
+            const Vec PH = P * H;                   // P symmetric: P H^T == (H P)^T
+            const float S = Linalg::Dot(H, PH) + R;
+            if (S <= 0.0f) return false;
+            if (gate > 0.0f && residual * residual > gate * gate * S) return false;
+
+            const float invS = 1.0f / S;
+            x += PH * (residual * invS);            // K = PH / S
+            Linalg::RankOneDowndate(P, PH, invS);   // P -= K S K^T = PH PH^T / S
+            return true;
+        }
+};
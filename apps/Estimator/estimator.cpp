@@ -0,0 +1,212 @@
+#include "apps/Estimator/estimator.hpp"
+#include "apps/EventDetector/event_detector.hpp"
+#include "queues/queues.hpp"
+#include "os/rtos.hpp"
+
+#include <cmath>
+
+namespace {
+
+constexpr float PI = 3.14159265358979f;
+constexpr float NOMINAL_DT = 0.001f;   // Used when timestamps do not advance
+constexpr float MAX_DT = 0.05f;        // Longer gaps are clamped, not integrated
+constexpr float MIN_COS_PITCH = 0.05f;
+
+enum { ROLL, PITCH, YAW, BGX, BGY, BGZ };
+enum { ALT, CLIMB, BAZ };
+
+inline float WrapPi(float a) {
+    while (a > PI) a -= 2.0f * PI;
+    while (a < -PI) a += 2.0f * PI;
+    return a;
+}
+
+// Sanity checks on the matrix library, evaluated at compile time
+constexpr Linalg::Matrix<2, 2> TWO_BY_TWO = {{{1.0f, 2.0f}, {3.0f, 4.0f}}};
+static_assert((TWO_BY_TWO * Linalg::Matrix<2, 2>::Identity())(1, 0) == 3.0f, "identity product");
+static_assert(Linalg::Congruence(TWO_BY_TWO, Linalg::Matrix<2, 2>::Identity())(0, 1) == 11.0f, "F F^T");
+
+} // namespace
+
+Estimator::Estimator(const EstimatorConfig& config) : config_(config) {
+    att_.P = Ekf<6>::Mat::Zero();
+    att_.P(ROLL, ROLL) = att_.P(PITCH, PITCH) = 0.1f;
+    att_.P(YAW, YAW) = 1.0f;
+    att_.P(BGX, BGX) = att_.P(BGY, BGY) = att_.P(BGZ, BGZ) = 1e-4f;
+
+    vert_.P = Ekf<3>::Mat::Zero();
+    vert_.P(ALT, ALT) = 10.0f;
+    vert_.P(CLIMB, CLIMB) = 1.0f;
+    vert_.P(BAZ, BAZ) = 0.1f;
+}
+
+void Estimator::Predict(const msg::imu& m) {
+    float dt = NOMINAL_DT;
+    if (started_ && m.ms != lastMs_) {
+        dt = (m.ms - lastMs_) * 0.001f;
+        if (dt > MAX_DT) dt = MAX_DT;
+    }
+    started_ = true;
+    lastMs_ = m.ms;
+
+    PredictAttitude(m, dt);
+    UpdateAttitude(m);
+    PredictVertical(m, dt);
+}
+
+void Estimator::PredictAttitude(const msg::imu& m, float dt) {
+    auto& x = att_.x;
+    const float p = m.gx - x[BGX];
+    const float q = m.gy - x[BGY];
+    const float r = m.gz - x[BGZ];
+
+    const float sr = std::sin(x[ROLL]), cr = std::cos(x[ROLL]);
+    float cp = std::cos(x[PITCH]);
+    if (std::fabs(cp) < MIN_COS_PITCH) cp = cp < 0.0f ? -MIN_COS_PITCH : MIN_COS_PITCH;
+    const float tp = std::sin(x[PITCH]) / cp;
+    const float secp = 1.0f / cp;
+
+    // Euler angle kinematics
+    const float qs = sr * q + cr * r;   // Terms shared by roll and yaw rates
+    const float qc = cr * q - sr * r;
+    x[ROLL] = WrapPi(x[ROLL] + (p + tp * qs) * dt);
+    x[PITCH] += qc * dt;
+    x[YAW] = WrapPi(x[YAW] + secp * qs * dt);
+
+    // F = I + A dt, A the Jacobian of the rates wrt angles and biases
+    Ekf<6>::Mat F = Ekf<6>::Mat::Identity();
+    F(ROLL, ROLL)  += tp * qc * dt;
+    F(ROLL, PITCH)  = secp * secp * qs * dt;
+    F(ROLL, BGX)    = -dt;
+    F(ROLL, BGY)    = -sr * tp * dt;
+    F(ROLL, BGZ)    = -cr * tp * dt;
+    F(PITCH, ROLL)  = -qs * dt;
+    F(PITCH, BGY)   = -cr * dt;
+    F(PITCH, BGZ)   = sr * dt;
+    F(YAW, ROLL)    = secp * qc * dt;
+    F(YAW, PITCH)   = secp * tp * qs * dt;
+    F(YAW, BGY)     = -sr * secp * dt;
+    F(YAW, BGZ)     = -cr * secp * dt;
+
+    Ekf<6>::Mat Q = Ekf<6>::Mat::Zero();
+    const float qa = config_.gyroNoise * config_.gyroNoise * dt;
+    const float qb = config_.gyroBiasWalk * config_.gyroBiasWalk * dt;
+    Q(ROLL, ROLL) = Q(PITCH, PITCH) = Q(YAW, YAW) = qa;
+    Q(BGX, BGX) = Q(BGY, BGY) = Q(BGZ, BGZ) = qb;
+
+    att_.Predict(F, Q);
+}
+
+void Estimator::UpdateAttitude(const msg::imu& m) {
+    // Gravity is only observable when nothing else is accelerating us
+    const float norm = std::sqrt(m.ax * m.ax + m.ay * m.ay + m.az * m.az);
+    if (std::fabs(norm - GRAVITY) > config_.accelGate * GRAVITY) return;
+
+    const float rollMeas = std::atan2(-m.ay, -m.az);
+    const float pitchMeas = std::atan2(m.ax, std::sqrt(m.ay * m.ay + m.az * m.az));
+    const float R = config_.accelAngleNoise * config_.accelAngleNoise;
+
+    Ekf<6>::Vec H = Ekf<6>::Vec::Zero();
+    H[ROLL] = 1.0f;
+    att_.Update(H, WrapPi(rollMeas - att_.x[ROLL]), R);
+
+    H = Ekf<6>::Vec::Zero();
+    H[PITCH] = 1.0f;
+    att_.Update(H, pitchMeas - att_.x[PITCH], R);
+    att_.x[ROLL] = WrapPi(att_.x[ROLL]);
+}
+
+void Estimator::PredictVertical(const msg::imu& m, float dt) {
+    // Vertical component of the specific force in the earth frame, up positive
+    const float sr = std::sin(att_.x[ROLL]), cr = std::cos(att_.x[ROLL]);
+    const float sp = std::sin(att_.x[PITCH]), cp = std::cos(att_.x[PITCH]);
+    const float fDown = -sp * m.ax + sr * cp * m.ay + cr * cp * m.az;
+    const float aUp = -fDown - GRAVITY - vert_.x[BAZ];
+
+    auto& x = vert_.x;
+    x[ALT] += (x[CLIMB] + 0.5f * aUp * dt) * dt;
+    x[CLIMB] += aUp * dt;
+
+    Ekf<3>::Mat F = Ekf<3>::Mat::Identity();
+    F(ALT, CLIMB) = dt;
+    F(ALT, BAZ) = -0.5f * dt * dt;
+    F(CLIMB, BAZ) = -dt;
+
+    Ekf<3>::Mat Q = Ekf<3>::Mat::Zero();
+    const float qa = config_.accelNoise * config_.accelNoise * dt;
+    Q(ALT, ALT) = qa * dt * dt * 0.25f;
+    Q(ALT, CLIMB) = Q(CLIMB, ALT) = qa * dt * 0.5f;
+    Q(CLIMB, CLIMB) = qa;
+    Q(BAZ, BAZ) = config_.accelBiasWalk * config_.accelBiasWalk * dt;
+
+    vert_.Predict(F, Q);
+}
+
+void Estimator::UpdateBaro(const msg::baro& m) {
+    if (m.pressure_pa <= 0.0f) return;
+    if (referencePa_ == 0.0f) referencePa_ = m.pressure_pa;  // Ground level
+
+    const float alt = PressureToAltitude(m.pressure_pa, referencePa_);
+    const float residual = alt - vert_.x[ALT];
+    const float R = config_.baroNoise * config_.baroNoise;
+    Ekf<3>::Vec H = Ekf<3>::Vec::Zero();
+    H[ALT] = 1.0f;
+    if (vert_.Update(H, residual, R, config_.baroGate)) {
+        baroRejects_ = 0;
+        return;
+    }
+    if (++baroRejects_ < config_.baroMaxRejects) return;
+
+    // Consistently far off: the estimate has drifted, so widen it until
+    // this sample passes the gate and let baro pull it back
+    vert_.P(ALT, ALT) += residual * residual;
+    vert_.Update(H, residual, R, config_.baroGate);
+    baroRejects_ = 0;
+}
+
+msg::est Estimator::Estimate() const {
+    msg::est e{};
+    e.roll = att_.x[ROLL];
+    e.pitch = att_.x[PITCH];
+    e.yaw = att_.x[YAW];
+    e.climb = vert_.x[CLIMB];
+    e.baro_alt = vert_.x[ALT];
+    e.ms = lastMs_;
+    return e;
+}
+
+float Estimator::PressureToAltitude(float pressurePa, float referencePa) {
+    return 44330.0f * (1.0f - std::pow(pressurePa / referencePa, 0.190295f));
+}
+
+void Estimator::Run(void*) {
+    static Estimator estimator;
+    static EventDetector detector;
+    Bus::Subscription<Topics::IMU> imu;
+    Bus::Subscription<Topics::BARO> baro;
+
+    while(true) {
+        msg::imu m;
+        if (!imu.receive(m)) continue;
+        estimator.Predict(m);
+
+        msg::baro b;
+        while (baro.try_receive(b)) {
+            estimator.UpdateBaro(b);
+
+            // Flight events run on raw baro altitude at the full sensor rate
+            if (b.pressure_pa <= 0.0f) continue;
+            msg::flight_event event;
+            float alt = PressureToAltitude(b.pressure_pa, estimator.ReferencePressure());
+            if (detector.Update(alt, b.ms, event)) {
+                Bus::Publish<Topics::FLIGHT_EVENT>(event);
+            }
+        }
+
+        // Every step on both: the EST topic carries each estimate (the
+        // flight recorder logs them all), the mailbox the newest one
+        const msg::est est = estimator.Estimate();
+        Topics::EstState.write(est);
+        Bus::Publish<Topics::EST>(est);
+    }
+}
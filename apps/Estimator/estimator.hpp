@@ -1,6 +1,64 @@
 #pragma once
+#include <cstdint>
+#include "msg/messages.hpp"
+#include "apps/Estimator/ekf.hpp"
+
+// Attitude + vertical channel estimator
+//
+// Two decoupled EKFs share the IMU stream:
+//   attitude  x = [roll, pitch, yaw, gyro bias x/y/z]   (rad, rad/s)
+//   vertical  x = [altitude, climb rate, accel bias]    (m, m/s, m/s^2)
+// Attitude is propagated with the gyro and corrected towards the gravity
+// direction from the accelerometer whenever |a| is close to 1 g. The
+// vertical channel integrates the earth-frame vertical acceleration and is
+// corrected by barometric altitude relative to the first baro sample.
+// Baro outliers are gated, but a run of rejections means the state has
+// drifted rather than the sensor: the altitude variance is then inflated
+// so the filter accepts baro again and reconverges.
+//
+// Body axes are forward-right-down, the accelerometer reports specific
+// force (a level vehicle at rest reads az = -g). Euler angles make yaw
+// singular at pitch = +-90 deg; cos(pitch) is clamped away from zero.
+struct EstimatorConfig {
+    float gyroNoise = 0.005f;       // rad/s, white noise on the rates
+    float gyroBiasWalk = 1e-5f;     // rad/s per sqrt(s)
+    float accelAngleNoise = 0.05f;  // rad, roll/pitch from the gravity vector
+    float accelGate = 0.1f;         // Use accel only if ||a| - g| < gate * g
+    float accelNoise = 0.5f;        // m/s^2, vertical acceleration
+    float accelBiasWalk = 0.01f;    // m/s^2 per sqrt(s)
+    float baroNoise = 0.5f;         // m
+    float baroGate = 5.0f;          // Reject baro residuals beyond gate sigmas...
+    uint32_t baroMaxRejects = 25;   // ...unless this many in a row (0.5 s at 50 Hz)
+};
 
 class Estimator {
     public:
+        static constexpr float GRAVITY = 9.80665f;
+
+        explicit Estimator(const EstimatorConfig& config = {});
+
+        // One full predict step, plus the accelerometer attitude update
+        void Predict(const msg::imu& m);
+        void UpdateBaro(const msg::baro& m);
+
+        msg::est Estimate() const;
+        float ReferencePressure() const { return referencePa_; }  // 0 until the first baro sample
+
+        // Standard atmosphere, metres above the reference pressure
+        static float PressureToAltitude(float pressurePa, float referencePa);
+
         static void Run(void* args); //Rtos task entry point
-};
\ No newline at end of file
+
+    private:
+        void PredictAttitude(const msg::imu& m, float dt);
+        void PredictVertical(const msg::imu& m, float dt);
+        void UpdateAttitude(const msg::imu& m);
+
+        EstimatorConfig config_;
+        Ekf<6> att_;
+        Ekf<3> vert_;
+        uint32_t lastMs_ = 0;
+        bool started_ = false;
+        float referencePa_ = 0.0f;
+        uint32_t baroRejects_ = 0;     // Consecutive gated baro samples
+};
@@ -0,0 +1,82 @@
+#include "apps/EventDetector/event_detector.hpp"
+
+#include <cmath>
+
+EventDetector::EventDetector(const EventDetectorConfig& config) : config_(config) {}
+
+void EventDetector::Reset() {
+    stats_.Reset();
+    minMax_.Reset();
+    phase_ = PAD;
+    h_ = v_ = pad_ = peak_ = 0.0f;
+    lastMs_ = 0;
+    started_ = false;
+    streak_ = 0;
+}
+
+bool EventDetector::Debounce(bool condition, uint16_t needed) {
+    streak_ = condition ? streak_ + 1 : 0;
+    if (streak_ < needed) return false;
+    streak_ = 0;
+    return true;
+}
+
+bool EventDetector::Update(float alt, uint32_t ms, msg::flight_event& event) {
+    if (!started_) {
+        h_ = pad_ = alt;
+        v_ = 0.0f;
+        lastMs_ = ms;
+        started_ = true;
+    }
+
+    // Alpha-beta filter; a repeated timestamp is treated as a 1 ms step
+    float dt = (ms - lastMs_) * 0.001f;
+    if (dt <= 0.0f) dt = 0.001f;
+    lastMs_ = ms;
+    const float predicted = h_ + v_ * dt;
+    const float residual = alt - predicted;
+    h_ = predicted + config_.alpha * residual;
+    v_ += config_.beta * residual / dt;
+
+    stats_.Push(alt);
+    minMax_.Push(alt);
+
+    switch (phase_) {
+        case PAD: {
+            // Follow slow pressure drift on the pad while the window is quiet
+            const float sigma = std::sqrt(stats_.Variance());
+            if (stats_.Full() && minMax_.Range() < config_.landedRange && sigma < config_.landedRange) {
+                pad_ = stats_.Mean();
+            }
+            if (Debounce(v_ > config_.launchClimb && h_ - pad_ > config_.launchHeight, config_.launchDebounce)) {
+                phase_ = ASCENT;
+                peak_ = h_;
+                event = msg::flight_event{msg::flight_event::LAUNCH, h_ - pad_, ms};
+                return true;
+            }
+            break;
+        }
+        case ASCENT: {
+            if (h_ > peak_) peak_ = h_;
+            if (Debounce(v_ < 0.0f && minMax_.Max() - alt > config_.apogeeDrop, config_.apogeeDebounce)) {
+                phase_ = DESCENT;
+                event = msg::flight_event{msg::flight_event::APOGEE, peak_ - pad_, ms};
+                return true;
+            }
+            break;
+        }
+        case DESCENT: {
+            const bool still = stats_.Full() && minMax_.Range() < config_.landedRange &&
+                               std::fabs(v_) < config_.landedSpeed;
+            if (Debounce(still, config_.landedDebounce)) {
+                phase_ = LANDED;
+                event = msg::flight_event{msg::flight_event::LANDING, stats_.Mean() - pad_, ms};
+                return true;
+            }
+            break;
+        }
+        case LANDED:
+            break;
+    }
+    return false;
+}
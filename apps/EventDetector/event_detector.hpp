@@ -0,0 +1,59 @@
+#pragma once
+#include <cstdint>
+#include "msg/messages.hpp"
+#include "utils/sliding_window.hpp"
+
+struct EventDetectorConfig {
+    float alpha = 0.2f;             // Alpha-beta filter gains on baro altitude
+    float beta = 0.02f;
+    float launchClimb = 10.0f;      // m/s
+    float launchHeight = 15.0f;     // m above the pad
+    float apogeeDrop = 3.0f;        // m below the window maximum
+    float landedRange = 2.0f;       // m, max - min over the window
+    float landedSpeed = 1.0f;       // m/s
+    uint16_t launchDebounce = 5;    // Consecutive samples before an event fires
+    uint16_t apogeeDebounce = 5;
+    uint16_t landedDebounce = 25;
+};
+
+// Launch / apogee / landing detection from barometric altitude
+//
+// Every sample updates an alpha-beta filter (altitude, vertical velocity)
+// and O(1) sliding windows over the raw altitude: mean/variance for the
+// pad reference, monotonic-deque min/max for apogee and touchdown. Each
+// condition must hold for its debounce count of consecutive samples, so
+// single outliers cannot fire an event. No allocation, constant work per
+// sample: cheap enough to run at the full baro rate.
+class EventDetector {
+    public:
+        static constexpr size_t WINDOW = 64;   // Samples, ~1.3 s at 50 Hz
+
+        enum Phase : uint8_t { PAD, ASCENT, DESCENT, LANDED };
+
+        explicit EventDetector(const EventDetectorConfig& config = {});
+
+        // Feeds one baro altitude (m, any fixed reference). Returns true and
+        // fills event when a flight event fires.
+        bool Update(float alt, uint32_t ms, msg::flight_event& event);
+
+        void Reset();
+
+        Phase GetPhase() const { return phase_; }
+        float Altitude() const { return h_ - pad_; }  // Filtered, m above the pad
+        float Velocity() const { return v_; }         // m/s, up positive
+        float PadAltitude() const { return pad_; }
+
+    private:
+        bool Debounce(bool condition, uint16_t needed);
+
+        EventDetectorConfig config_;
+        SlidingStats<WINDOW> stats_;
+        SlidingMinMax<WINDOW> minMax_;
+        Phase phase_ = PAD;
+        float h_ = 0.0f, v_ = 0.0f;   // Alpha-beta state, absolute altitude
+        float pad_ = 0.0f;
+        float peak_ = 0.0f;
+        uint32_t lastMs_ = 0;
+        bool started_ = false;
+        uint16_t streak_ = 0;
+};
@@ -0,0 +1,195 @@
+#include "apps/FlightRecorder/flight_log.hpp"
+#include "utils/crc16.hpp"
+
+#include <cstring>
+
+namespace FlightLog {
+
+// Room kept back so the last sync point always fits
+static constexpr size_t SYNC_RECORD_LEN = RECORD_HEADER_LEN + sizeof(SyncPoint);
+
+// CRC over type, len, us and payload, seeded with the log id
+static uint16_t RecordCrc(uint32_t logId, const uint8_t* rec, size_t payloadLen) {
+    uint8_t id[4];
+    std::memcpy(id, &logId, sizeof(id));
+    uint16_t crc = Crc16::Compute(id, sizeof(id));
+    crc = Crc16::Compute(rec, 2, crc);
+    return Crc16::Compute(rec + 4, RECORD_HEADER_LEN - 4 + payloadLen, crc);
+}
+
+static uint16_t HeaderCrc(const Header& h) {
+    return Crc16::Compute(reinterpret_cast<const uint8_t*>(&h), offsetof(Header, crc));
+}
+
+bool ReadHeader(const uint8_t* region, size_t size, int slot, Header& h) {
+    if (size < HEADER_AREA) return false;
+    std::memcpy(&h, region + slot * HEADER_SLOT, sizeof(Header));
+    return h.magic == MAGIC && h.version == VERSION && h.headerSize == sizeof(Header) &&
+           h.crc == HeaderCrc(h) && h.capacity == size - HEADER_AREA && h.committed <= h.capacity;
+}
+
+// Newer of the two valid copies, false if neither is
+static bool LatestHeader(const uint8_t* region, size_t size, Header& h) {
+    Header a, b;
+    const bool okA = ReadHeader(region, size, 0, a);
+    const bool okB = ReadHeader(region, size, 1, b);
+    if (okA && okB) h = static_cast<int32_t>(b.seq - a.seq) > 0 ? b : a;
+    else if (okA) h = a;
+    else if (okB) h = b;
+    return okA || okB;
+}
+
+//== Writer ==//
+
+Writer::Writer(uint8_t* region, size_t size)
+    : region_(region), size_(size), records_(region + HEADER_AREA) {}
+
+bool Writer::Open(bool erase) {
+    if (size_ < HEADER_AREA + 2 * SYNC_RECORD_LEN) return false;
+    full_ = false;
+
+    Header previous;
+    const bool intact = LatestHeader(region_, size_, previous);
+    if (intact && !erase) {
+        // Pick up after the last record that still checks out
+        Reader reader(region_, size_);
+        reader.Open();
+        Record r;
+        uint64_t records = 0;
+        while (reader.Next(r)) {
+            if (r.type != SYNC) records++;
+        }
+        header_ = previous;
+        header_.records = records;
+        header_.boots++;
+        end_ = reader.End();
+        synced_ = header_.committed;
+        Terminate();   // Made durable by the first sync point
+        return true;
+    }
+
+    // New log; a new id keeps the old log's records from validating
+    header_ = Header{};
+    header_.magic = MAGIC;
+    header_.version = VERSION;
+    header_.headerSize = sizeof(Header);
+    header_.logId = intact ? previous.logId + 1 : 1;
+    header_.capacity = size_ - HEADER_AREA;
+    std::memset(region_, 0, HEADER_AREA);
+    end_ = 0;
+    synced_ = 0;
+    Terminate();
+    return true;
+}
+
+bool Writer::Put(uint8_t type, uint64_t us, const void* payload, size_t len, uint64_t limit) {
+    if (len > MAX_PAYLOAD_LEN || end_ + RECORD_HEADER_LEN + len > limit) return false;
+    uint8_t* rec = records_ + end_;
+    rec[0] = type;
+    rec[1] = static_cast<uint8_t>(len);
+    std::memcpy(rec + 4, &us, sizeof(us));
+    std::memcpy(rec + RECORD_HEADER_LEN, payload, len);
+    const uint16_t crc = RecordCrc(header_.logId, rec, len);
+    std::memcpy(rec + 2, &crc, sizeof(crc));
+    end_ += RECORD_HEADER_LEN + len;
+    Terminate();
+    return true;
+}
+
+// Zeroes the record header at end_: a reader stops there, even if an
+// intact record from an earlier boot happens to start at the same offset
+void Writer::Terminate() {
+    if (end_ + RECORD_HEADER_LEN <= header_.capacity) std::memset(records_ + end_, 0, RECORD_HEADER_LEN);
+}
+
+bool Writer::Append(uint8_t type, uint64_t us, const void* payload, size_t len) {
+    if (full_ || type == EMPTY || type == SYNC) return false;
+    if (!Put(type, us, payload, len, header_.capacity - SYNC_RECORD_LEN)) {
+        if (len <= MAX_PAYLOAD_LEN) full_ = true;
+        return false;
+    }
+    header_.records++;
+    return true;
+}
+
+Range Writer::BeginSync(uint64_t us, uint64_t lost) {
+    header_.lost = lost;
+    const SyncPoint point{SYNC_MAGIC, header_.seq + 1, header_.boots, header_.records, lost};
+    Put(SYNC, us, &point, sizeof(point), header_.capacity);   // Skipped once even the reserve is used
+    syncEnd_ = end_;
+    syncRecords_ = header_.records;
+
+    // Up to and including the zeroed header that ends the log
+    const uint64_t terminator = header_.capacity - end_ < RECORD_HEADER_LEN ? header_.capacity - end_ : RECORD_HEADER_LEN;
+    return Range{HEADER_AREA + static_cast<size_t>(synced_), static_cast<size_t>(end_ + terminator - synced_)};
+}
+
+// Commits what BeginSync covered; records appended since are left for the
+// next sync point. Alternates between the two header slots, so a torn
+// write only ever hits the copy that is not the latest valid one.
+Range Writer::EndSync() {
+    header_.committed = syncEnd_;
+    header_.seq++;
+    synced_ = syncEnd_;
+
+    Header h = header_;
+    h.records = syncRecords_;
+    h.crc = HeaderCrc(h);
+    const size_t offset = (h.seq & 1) * HEADER_SLOT;
+    std::memcpy(region_ + offset, &h, sizeof(Header));
+    return Range{offset, sizeof(Header)};
+}
+
+//== Reader ==//
+
+Reader::Reader(const uint8_t* region, size_t size)
+    : region_(region), size_(size), records_(region + HEADER_AREA) {}
+
+bool Reader::Open() {
+    pos_ = 0;
+    skipped_ = 0;
+    return LatestHeader(region_, size_, header_);
+}
+
+bool Reader::Parse(uint64_t at, Record& r) const {
+    if (at + RECORD_HEADER_LEN > header_.capacity) return false;
+    const uint8_t* rec = records_ + at;
+    if (rec[0] == EMPTY || at + RECORD_HEADER_LEN + rec[1] > header_.capacity) return false;
+
+    uint16_t crc;
+    std::memcpy(&crc, rec + 2, sizeof(crc));
+    if (crc != RecordCrc(header_.logId, rec, rec[1])) return false;
+
+    r.type = rec[0];
+    r.len = rec[1];
+    std::memcpy(&r.us, rec + 4, sizeof(r.us));
+    r.payload = rec + RECORD_HEADER_LEN;
+    r.offset = at;
+    if (r.type == SYNC) {
+        uint64_t magic;
+        if (r.len != sizeof(SyncPoint)) return false;
+        std::memcpy(&magic, r.payload, sizeof(magic));
+        return magic == SYNC_MAGIC;
+    }
+    return true;
+}
+
+bool Reader::Next(Record& r) {
+    if (header_.magic != MAGIC) return false;
+    while (true) {
+        if (Parse(pos_, r)) {
+            pos_ += RECORD_HEADER_LEN + r.len;
+            return true;
+        }
+        // Past the committed part a bad record is the torn tail of a crash
+        if (pos_ >= header_.committed) return false;
+
+        // Corruption inside it: resume at the next sync point
+        uint64_t next = pos_ + 1;
+        while (next < header_.committed && !(records_[next] == SYNC && Parse(next, r))) next++;
+        skipped_ += next - pos_;
+        pos_ = next;
+    }
+}
+
+} // namespace FlightLog
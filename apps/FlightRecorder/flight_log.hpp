@@ -0,0 +1,171 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+// Crash-safe flight log layout
+//
+// A log fills one fixed-size persistent region:
+//
+//   | header A | header B | ... | records ... (up to the region end)
+//     0          512            HEADER_AREA
+//
+// Each record is self-checking, little-endian:
+//
+//   | type | len | crc16 (u16) | us (u64) | payload (len) |
+//     1 B    1 B   2 B           8 B
+//
+// type tags the message (FlightRecorder::RecordType of its topic, or SYNC),
+// us is the writer's NowUs() when it was recorded, and the payload is the
+// message struct as it sits in memory. The CRC (CRC-16/CCITT-FALSE) covers type, len, us and payload
+// and is seeded with the log id, so records left over from an earlier log
+// in the same region never validate.
+//
+// Every sync point appends a SYNC record, makes the records durable and
+// then writes the header copy not written last time, so one of the two
+// copies is always intact. A reader trusts everything up to the header's
+// committed offset, and after that keeps reading records as long as their
+// CRCs hold: a crash loses at most the record being written. Past a
+// corrupted record inside the committed part it skips to the next SYNC.
+//
+// The writer keeps the record header after the last record zeroed, also
+// right after reopening a log, so records left behind by an earlier boot
+// past a torn one can never be read back as part of the log.
+namespace FlightLog {
+
+constexpr uint32_t MAGIC = 0x52465343;           // "CSFR"
+constexpr uint16_t VERSION = 1;
+constexpr size_t HEADER_SLOT = 512;
+constexpr size_t HEADER_AREA = 4096;             // One page: headers never share one with records
+constexpr size_t RECORD_HEADER_LEN = 1 + 1 + 2 + 8;
+constexpr size_t MAX_PAYLOAD_LEN = 255;          // len is one byte
+
+constexpr uint8_t EMPTY = 0x00;                  // Unwritten (zero-filled) space
+constexpr uint8_t SYNC = 0xFE;
+constexpr uint64_t SYNC_MAGIC = 0x434E59532D524653ull;
+
+struct Header {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t logId;          // Seeds the record CRCs
+    uint32_t seq;            // Bumped per commit; the valid copy with the higher one wins
+    uint64_t capacity;       // Record area size in bytes
+    uint64_t committed;      // Record bytes known durable
+    uint64_t records;        // Records written (excluding SYNC)
+    uint64_t lost;           // Messages the recorder could not keep
+    uint32_t boots;          // Times this log was reopened after a reset
+    uint16_t reserved;
+    uint16_t crc;            // Over every byte before it
+};
+static_assert(std::is_trivially_copyable<Header>::value, "Header is copied as bytes");
+static_assert(sizeof(Header) <= HEADER_SLOT, "Header must fit its slot");
+
+// Payload of a SYNC record
+struct SyncPoint {
+    uint64_t magic;          // SYNC_MAGIC, lets a reader find it by scanning
+    uint32_t seq;            // Header seq this sync point commits
+    uint32_t boots;
+    uint64_t records;
+    uint64_t lost;
+};
+
+struct Range {
+    size_t offset;           // From the region start
+    size_t len;
+};
+
+// Appends records into a region. No locking: Append, BeginSync and EndSync
+// must not run concurrently. The caller makes the returned ranges durable
+// (Rtos::PersistentRegion::sync) between the sync calls, and may append
+// meanwhile; EndSync only commits what BeginSync covered.
+class Writer {
+    public:
+        Writer(uint8_t* region, size_t size);
+
+        // Continues an intact log after its last valid record (a reset
+        // mid-flight keeps what was recorded), or starts a new one if there
+        // is none or erase is set. False if the region is too small.
+        // Nothing is durable until the first sync point.
+        bool Open(bool erase = false);
+
+        // false when the log is full or len exceeds MAX_PAYLOAD_LEN
+        bool Append(uint8_t type, uint64_t us, const void* payload, size_t len);
+
+        template <typename Msg>
+        bool Append(uint8_t type, uint64_t us, const Msg& m) {
+            static_assert(std::is_trivially_copyable<Msg>::value, "messages are stored as bytes");
+            static_assert(sizeof(Msg) <= MAX_PAYLOAD_LEN, "message too large for one record");
+            return Append(type, us, &m, sizeof(Msg));
+        }
+
+        // Sync point, in two steps so the data is durable before the header
+        // points past it:
+        //   region.sync(w.BeginSync(us, lost));  region.sync(w.EndSync());
+        Range BeginSync(uint64_t us, uint64_t lost);
+        Range EndSync();
+
+        const Header& Info() const { return header_; }
+        uint64_t Used() const { return end_; }       // Record bytes written
+        bool Full() const { return full_; }
+
+    private:
+        bool Put(uint8_t type, uint64_t us, const void* payload, size_t len, uint64_t limit);
+        void Terminate();
+
+        uint8_t* region_;
+        size_t size_;
+        uint8_t* records_;
+        Header header_{};
+        uint64_t end_ = 0;           // Append offset in the record area
+        uint64_t synced_ = 0;        // Durable up to here
+        uint64_t syncEnd_ = 0;       // End of the sync point in progress
+        uint64_t syncRecords_ = 0;   // Records up to syncEnd_
+        bool full_ = false;
+};
+
+struct Record {
+    uint8_t type;
+    uint8_t len;
+    uint64_t us;
+    const uint8_t* payload;
+    uint64_t offset;                 // In the record area
+
+    template <typename Msg>
+    bool As(Msg& m) const {
+        if (len != sizeof(Msg)) return false;
+        std::memcpy(&m, payload, sizeof(Msg));
+        return true;
+    }
+};
+
+// Reads a log back, after a clean shutdown or a crash
+class Reader {
+    public:
+        Reader(const uint8_t* region, size_t size);
+
+        bool Open();                          // false if neither header copy is valid
+        const Header& Info() const { return header_; }
+
+        // Next intact record including SYNC ones; false at the end of the log
+        bool Next(Record& r);
+
+        uint64_t End() const { return pos_; }            // Offset after the last record read
+        uint64_t Skipped() const { return skipped_; }    // Bytes passed over as corrupt
+
+    private:
+        bool Parse(uint64_t at, Record& r) const;
+
+        const uint8_t* region_;
+        size_t size_;
+        const uint8_t* records_;
+        Header header_{};
+        uint64_t pos_ = 0;
+        uint64_t skipped_ = 0;
+};
+
+// Header copy at slot, or false if it is missing or torn
+bool ReadHeader(const uint8_t* region, size_t size, int slot, Header& h);
+
+} // namespace FlightLog
@@ -0,0 +1,141 @@
+#include "apps/FlightRecorder/flight_recorder.hpp"
+#include "apps/FlightRecorder/flight_log.hpp"
+#include "apps/Logger/logger.hpp"
+#include "queues/queues.hpp"
+#include "os/rtos.hpp"
+
+#include <atomic>
+
+static const char* g_regionName = FlightRecorder::DEFAULT_REGION;
+static bool g_erase = false;
+
+static std::atomic<uint64_t> g_recorded{0};
+static std::atomic<uint64_t> g_lost{0};
+
+static Rtos::EventGroup g_state;
+static constexpr uint32_t SUBSCRIBED_BIT = 0x1;
+
+// Shared by the drain and sync tasks
+static Rtos::PersistentRegion g_region;
+static FlightLog::Writer* g_log = nullptr;
+static Rtos::Mutex g_logLock;                   // Serialises Writer calls, never held across a sync
+static Rtos::Task g_syncTask;
+
+// One topic's subscription, drained into the log
+template <Topics::Id id>
+struct Channel {
+    Bus::Subscription<id> sub;     // DROP_OLDEST: never holds up a publisher
+    uint64_t lostSeen = 0;         // Overruns already counted
+
+    void Drain(FlightLog::Writer& log, uint64_t now) {
+        Bus::MessageOf<id> m;
+        uint64_t recorded = 0, lost = 0;
+        while (sub.try_receive(m)) {
+            if (log.Append(FlightRecorder::RecordType(id), now, m)) recorded++;
+            else lost++;
+        }
+        lost += sub.lost() - lostSeen;
+        lostSeen = sub.lost();
+        if (recorded) g_recorded.fetch_add(recorded, std::memory_order_relaxed);
+        if (lost) g_lost.fetch_add(lost, std::memory_order_relaxed);
+    }
+};
+
+// Data first, then the header that commits it. Only the Writer calls
+// hold the lock: the drain keeps appending while the region is flushed.
+static void Sync() {
+    g_logLock.lock();
+    const FlightLog::Range data = g_log->BeginSync(Rtos::NowUs(), g_lost.load(std::memory_order_relaxed));
+    g_logLock.unlock();
+    if (!g_region.sync(data.offset, data.len)) Logger::Error("[FlightRecorder] sync failed");
+
+    g_logLock.lock();
+    const FlightLog::Range header = g_log->EndSync();
+    g_logLock.unlock();
+    g_region.sync(header.offset, header.len);
+}
+
+static void SyncLoop(void*) {
+    uint64_t next = Rtos::NowUs();
+    while (true) {
+        next += FlightRecorder::SYNC_PERIOD_MS * 1000;
+        Rtos::SleepUntilUs(next);
+        Sync();
+        const uint64_t now = Rtos::NowUs();
+        if (now > next) next = now;   // A sync took longer than the period: don't catch up
+    }
+}
+
+void FlightRecorder::Configure(const char* region, bool erase) {
+    g_regionName = region ? region : DEFAULT_REGION;
+    g_erase = erase;
+}
+
+bool FlightRecorder::WaitSubscribed(int timeout_ms) {
+    return (g_state.wait(SUBSCRIBED_BIT, false, false, timeout_ms) & SUBSCRIBED_BIT) != 0;
+}
+
+uint64_t FlightRecorder::Recorded() {
+    return g_recorded.load(std::memory_order_relaxed);
+}
+
+uint64_t FlightRecorder::Lost() {
+    return g_lost.load(std::memory_order_relaxed);
+}
+
+void FlightRecorder::Run(void*) {
+    // Subscribe before the (possibly slow) region setup so nothing is missed
+    static Channel<Topics::RAW_IMU> rawImu;
+    static Channel<Topics::IMU> imu;
+    static Channel<Topics::BARO> baro;
+    static Channel<Topics::GNSS> gnss;
+    static Channel<Topics::EST> est;
+    static Channel<Topics::FLIGHT_EVENT> events;
+    static Channel<Topics::CMD> cmds;
+    static Channel<Topics::CMD_ACK> acks;
+    g_state.set(SUBSCRIBED_BIT);
+
+    if (!g_region.open(g_regionName, REGION_SIZE)) {
+        Logger::Error("[FlightRecorder] cannot open %s, not recording", g_regionName);
+        return;
+    }
+    static FlightLog::Writer log(g_region.data(), g_region.size());
+    if (!log.Open(g_erase)) {
+        Logger::Error("[FlightRecorder] %s is too small", g_regionName);
+        return;
+    }
+    const FlightLog::Header& info = log.Info();
+    Logger::Info("[FlightRecorder] log %u in %s: %llu records, boot %u",
+                 info.logId, g_regionName, info.records, info.boots);
+    g_log = &log;
+    Sync();
+    g_syncTask.Create("FlightRecorderSync", SyncLoop, nullptr);
+
+    bool reportedFull = false;
+    uint64_t next = Rtos::NowUs();
+    while (true) {
+        next += DRAIN_PERIOD_MS * 1000;
+        Rtos::SleepUntilUs(next);
+        const uint64_t now = Rtos::NowUs();
+        if (now > next + DRAIN_PERIOD_MS * 1000) next = now;   // Fell behind: don't burst
+
+        g_logLock.lock();
+
+        rawImu.Drain(log, now);
+        imu.Drain(log, now);
+        baro.Drain(log, now);
+        gnss.Drain(log, now);
+        est.Drain(log, now);
+        events.Drain(log, now);
+        cmds.Drain(log, now);
+        acks.Drain(log, now);
+        const bool full = log.Full();
+        const uint64_t records = log.Info().records;
+        g_logLock.unlock();
+
+        if (full && !reportedFull) {
+            Logger::Warn("[FlightRecorder] log full after %llu records", records);
+            reportedFull = true;
+        }
+    }
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "os/rtos.hpp"
+
+// Flight data recorder
+//
+// Subscribes to every bus topic and appends each message, tagged with its
+// topic id and timestamped, to a crash-safe log (flight_log.hpp) in a
+// preallocated persistent region: a memory-mapped file on Linux, a raw
+// flash partition on the MCU. Only topic traffic is recorded, not
+// mailbox state, so producers whose output must be logged in full (the
+// Estimator) publish every sample on their topic.
+//
+// Producers are never held up: the recorder is just one more DROP_OLDEST
+// subscriber, so its per-topic lock-free rings absorb a slow drain and
+// overruns are counted instead of blocking a publisher. The task drains
+// all topics every DRAIN_PERIOD_MS with plain stores into the mapping. A
+// second, default-priority task it starts makes the log durable every
+// SYNC_PERIOD_MS, so a slow flush never holds up the drain (and the rings
+// behind it), and a crash or power loss costs at most the last sync period
+// (and usually nothing).
+class FlightRecorder {
+    public:
+        static constexpr size_t REGION_SIZE = 64u << 20;        // ~4.5 min at full sensor rate (~240 kB/s)
+        static constexpr uint32_t DRAIN_PERIOD_MS = 10;
+        static constexpr uint32_t SYNC_PERIOD_MS = 500;
+        static constexpr const char* DEFAULT_REGION = "flight.rec";
+
+        // Record type of a topic's messages (type 0 marks unwritten space)
+        static constexpr uint8_t RecordType(int topic) { return static_cast<uint8_t>(topic + 1); }
+
+        // Call before the task is started. A reset keeps appending to the
+        // same log; erase starts a new one (on the pad, before arming).
+        static void Configure(const char* region, bool erase = false);
+
+        // Blocks until the task has subscribed to every topic; call after
+        // creating it, before starting producers, so none of their
+        // messages are missed. false on timeout.
+        static bool WaitSubscribed(int timeout_ms = Rtos::MAX_TIMEOUT);
+
+        static uint64_t Recorded();   // Messages written to the log
+        static uint64_t Lost();       // Messages missed (overruns, or the log full)
+
+        static void Run(void* args); //Rtos task entry point
+};
@@ -0,0 +1,355 @@
+#include "apps/Gnss/gnss_parser.hpp"
+#include "queues/queues.hpp"
+#include "os/rtos.hpp"
+
+#include <cstring>
+
+namespace {
+
+constexpr uint16_t MAX_UBX_LEN = 1024;   // Anything longer is a false sync
+constexpr int COORD_DECIMALS = 7;        // Fraction digits of minutes kept
+constexpr int64_t POW10[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000};
+
+bool PublishGnss(const msg::gnss& g, void*) {
+    return Bus::Publish<Topics::GNSS>(g);
+}
+
+inline int HexValue(char c) {
+    if (c >= '0' && c <= '9') return c - '0';
+    if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+    if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+    return -1;
+}
+
+inline bool IsDigit(char c) { return c >= '0' && c <= '9'; }
+
+inline int32_t GetI32(const uint8_t* p) {
+    return static_cast<int32_t>(static_cast<uint32_t>(p[0]) |
+                                static_cast<uint32_t>(p[1]) << 8 |
+                                static_cast<uint32_t>(p[2]) << 16 |
+                                static_cast<uint32_t>(p[3]) << 24);
+}
+
+} // namespace
+
+//== Field parsing ==//
+// Fields are views into the line buffer; nothing here copies or allocates.
+
+bool GnssParser::ParseUInt(const Field& f, uint32_t& out) {
+    if (f.len == 0) return false;
+    uint32_t v = 0;
+    for (uint8_t i = 0; i < f.len; ++i) {
+        if (!IsDigit(f.p[i])) return false;
+        v = v * 10 + static_cast<uint32_t>(f.p[i] - '0');
+    }
+    out = v;
+    return true;
+}
+
+// Decimal number scaled by 10^decimals; extra fraction digits are
+// truncated, more than MAX_INT_DIGITS integer digits fail the parse
+bool GnssParser::ParseFixed(const Field& f, int decimals, int64_t& out) {
+    if (f.len == 0) return false;
+    uint8_t i = 0;
+    bool negative = false;
+    if (f.p[0] == '-' || f.p[0] == '+') {
+        negative = f.p[0] == '-';
+        i = 1;
+    }
+    int64_t v = 0;
+    int frac = -1;   // Fraction digits taken, -1 before the '.'
+    int intDigits = 0;
+    bool digits = false;
+    for (; i < f.len; ++i) {
+        const char c = f.p[i];
+        if (c == '.' && frac < 0) { frac = 0; continue; }
+        if (!IsDigit(c)) return false;
+        if (frac < 0 && ++intDigits > MAX_INT_DIGITS) return false;
+        digits = true;
+        if (frac >= decimals) continue;
+        v = v * 10 + (c - '0');
+        if (frac >= 0) frac++;
+    }
+    if (!digits) return false;
+    v *= POW10[decimals - (frac < 0 ? 0 : frac)];
+    out = negative ? -v : v;
+    return true;
+}
+
+// NMEA (d)ddmm.mmmm + hemisphere -> degrees * 1e7
+bool GnssParser::ParseCoordinate(const Field& value, const Field& hemi, int32_t& e7) {
+    int64_t ddmm;
+    if (!ParseFixed(value, COORD_DECIMALS, ddmm) || ddmm < 0 || hemi.len != 1) return false;
+    const int64_t perDegree = 100 * POW10[COORD_DECIMALS];   // "dd" sits above two minute digits
+    const int64_t degrees = ddmm / perDegree;
+    const int64_t minutesE7 = ddmm % perDegree;
+    int64_t v = degrees * 10000000 + (minutesE7 + 30) / 60;
+    if (v > 1800000000) return false;
+    if (hemi.p[0] == 'S' || hemi.p[0] == 'W') v = -v;
+    else if (hemi.p[0] != 'N' && hemi.p[0] != 'E') return false;
+    e7 = static_cast<int32_t>(v);
+    return true;
+}
+
+//== Parser ==//
+
+GnssParser::GnssParser() : GnssParser(PublishGnss, nullptr) {}
+
+GnssParser::GnssParser(Sink sink, void* ctx) : sink_(sink), ctx_(ctx) {}
+
+void GnssParser::Reset() {
+    state_ = State::IDLE;
+    lineLen_ = 0;
+    ubxPos_ = 0;
+}
+
+size_t GnssParser::Feed(const uint8_t* data, size_t len) {
+    size_t published = 0;
+    size_t i = 0;
+    while (i < len) {
+        // Sentence bodies are most of the stream: copy them in a tight loop
+        // and leave only terminators and binary data to the state machine
+        if (state_ == State::NMEA) {
+            const size_t room = MAX_SENTENCE_LEN - lineLen_;
+            const size_t end = len - i < room ? len : i + room;
+            uint8_t sum = xor_;
+            size_t k = i;
+            for (; k < end; ++k) {
+                const uint8_t b = data[k];
+                if (b == '\r' || b == '\n' || b == '$') break;
+                line_[lineLen_++] = static_cast<char>(b);
+                sum ^= b;
+            }
+            xor_ = sum;
+            i = k;
+            if (i == len) break;
+        }
+        published += Step(data[i++]);
+    }
+    return published;
+}
+
+size_t GnssParser::Step(uint8_t byte) {
+    switch (state_) {
+        case State::IDLE:
+            if (byte == '$') {
+                lineLen_ = 0;
+                xor_ = 0;
+                state_ = State::NMEA;
+            } else if (byte == UBX_SYNC_0) {
+                state_ = State::UBX_SYNC_1;
+            }
+            return 0;
+
+        case State::NMEA:
+            if (byte == '\r' || byte == '\n') {
+                state_ = State::IDLE;
+                return EndSentence();
+            }
+            if (byte == '$') {          // Truncated sentence, start over
+                lineLen_ = 0;
+                xor_ = 0;
+                return 0;
+            }
+            if (lineLen_ == MAX_SENTENCE_LEN) {
+                stats_.overflows++;
+                state_ = State::IDLE;
+                return 0;
+            }
+            line_[lineLen_++] = static_cast<char>(byte);
+            xor_ ^= byte;
+            return 0;
+
+        case State::UBX_SYNC_1:
+            if (byte != UBX_SYNC_1) {
+                state_ = State::IDLE;
+                return Step(byte);      // May be a '$'
+            }
+            ubxPos_ = 0;
+            ckA_ = ckB_ = 0;
+            state_ = State::UBX_HEADER;
+            return 0;
+
+        case State::UBX_HEADER:
+            ubxHeader_[ubxPos_++] = byte;
+            ckA_ += byte;
+            ckB_ += ckA_;
+            if (ubxPos_ == sizeof(ubxHeader_)) {
+                ubxLen_ = static_cast<uint16_t>(ubxHeader_[2] | ubxHeader_[3] << 8);
+                if (ubxLen_ > MAX_UBX_LEN) {
+                    stats_.checksumErrors++;
+                    state_ = State::IDLE;
+                    return 0;
+                }
+                ubxPos_ = 0;
+                state_ = ubxLen_ ? State::UBX_PAYLOAD : State::UBX_CK_A;
+            }
+            return 0;
+
+        case State::UBX_PAYLOAD:
+            if (ubxPos_ < sizeof(ubxPayload_)) ubxPayload_[ubxPos_] = byte;  // Longer messages are only checksummed
+            ubxPos_++;
+            ckA_ += byte;
+            ckB_ += ckA_;
+            if (ubxPos_ == ubxLen_) state_ = State::UBX_CK_A;
+            return 0;
+
+        case State::UBX_CK_A:
+            if (byte != ckA_) {
+                stats_.checksumErrors++;
+                state_ = State::IDLE;
+                return 0;
+            }
+            state_ = State::UBX_CK_B;
+            return 0;
+
+        case State::UBX_CK_B:
+            state_ = State::IDLE;
+            if (byte != ckB_) {
+                stats_.checksumErrors++;
+                return 0;
+            }
+            return EndUbx();
+    }
+    return 0;
+}
+
+size_t GnssParser::EndSentence() {
+    // "<address>,<fields>*hh": the checksum covers everything before '*'
+    if (lineLen_ < 3 || line_[lineLen_ - 3] != '*') {
+        if (lineLen_ > 0) stats_.checksumErrors++;
+        return 0;
+    }
+    const size_t bodyLen = lineLen_ - 3;
+    const int hi = HexValue(line_[lineLen_ - 2]);
+    const int lo = HexValue(line_[lineLen_ - 1]);
+    // xor_ ran over the whole line; take the "*hh" suffix back out
+    const uint8_t sum = xor_ ^ '*' ^ static_cast<uint8_t>(line_[lineLen_ - 2]) ^
+                        static_cast<uint8_t>(line_[lineLen_ - 1]);
+    if (hi < 0 || lo < 0 || sum != (hi << 4 | lo)) {
+        stats_.checksumErrors++;
+        return 0;
+    }
+    stats_.sentences++;
+
+    // Address is <talker (2)><type (3)>; any talker (GP, GN, GL, ...) is
+    // accepted. Only wanted sentences are tokenized.
+    const bool gga = bodyLen > 6 && line_[5] == ',' && std::memcmp(line_ + 2, "GGA", 3) == 0;
+    const bool rmc = bodyLen > 6 && line_[5] == ',' && std::memcmp(line_ + 2, "RMC", 3) == 0;
+    if (!gga && !rmc) {
+        stats_.ignored++;
+        return 0;
+    }
+
+    // Tokenize in place
+    Field fields[MAX_FIELDS];
+    size_t n = 0;
+    size_t start = 0;
+    for (size_t i = 0; i <= bodyLen && n < MAX_FIELDS; ++i) {
+        if (i == bodyLen || line_[i] == ',') {
+            fields[n++] = Field{line_ + start, static_cast<uint8_t>(i - start)};
+            start = i + 1;
+        }
+    }
+
+    return gga ? HandleGga(fields, n) : HandleRmc(fields, n);
+}
+
+size_t GnssParser::HandleGga(const Field* f, size_t n) {
+    // 1 time, 2 lat, 3 N/S, 4 lon, 5 E/W, 6 quality, 7 sats, 8 hdop, 9 alt
+    const uint64_t now = Rtos::NowUs();
+    if (n < 10 || now < pvtUntilUs_) {
+        stats_.ignored++;
+        return 0;
+    }
+    ggaUntilUs_ = now + SOURCE_TIMEOUT_MS * 1000ULL;
+
+    uint32_t quality = 0, sats = 0;
+    ParseUInt(f[6], quality);
+    ParseUInt(f[7], sats);
+    fix_.sats = static_cast<uint8_t>(sats > 255 ? 255 : sats);
+    fix_.fix = quality > 0;
+
+    int32_t lat, lon;
+    int64_t altMm;
+    if (fix_.fix && ParseCoordinate(f[2], f[3], lat) &&
+                    ParseCoordinate(f[4], f[5], lon)) {
+        fix_.lat = lat * 1e-7;
+        fix_.lon = lon * 1e-7;
+        if (ParseFixed(f[9], 3, altMm)) fix_.alt = static_cast<float>(altMm) * 1e-3f;
+    } else {
+        fix_.fix = false;   // Keep the last position, flag it stale
+    }
+    return Publish();
+}
+
+size_t GnssParser::HandleRmc(const Field* f, size_t n) {
+    // 1 time, 2 status, 3 lat, 4 N/S, 5 lon, 6 E/W
+    const uint64_t now = Rtos::NowUs();
+    if (n < 7 || now < ggaUntilUs_ || now < pvtUntilUs_) {
+        stats_.ignored++;
+        return 0;
+    }
+
+    int32_t lat, lon;
+    fix_.fix = f[2].len == 1 && f[2].p[0] == 'A';
+    if (fix_.fix && ParseCoordinate(f[3], f[4], lat) &&
+                    ParseCoordinate(f[5], f[6], lon)) {
+        fix_.lat = lat * 1e-7;
+        fix_.lon = lon * 1e-7;
+    } else {
+        fix_.fix = false;
+    }
+    return Publish();
+}
+
+size_t GnssParser::EndUbx() {
+    if (ubxHeader_[0] != UBX_CLASS_NAV || ubxHeader_[1] != UBX_ID_NAV_PVT || ubxLen_ != NAV_PVT_LEN) {
+        stats_.ignored++;
+        return 0;
+    }
+
+    pvtUntilUs_ = Rtos::NowUs() + SOURCE_TIMEOUT_MS * 1000ULL;
+    const uint8_t* p = ubxPayload_;
+    const uint8_t fixType = p[20];
+    const bool fixOk = (p[21] & 0x01) != 0;
+    fix_.fix = fixOk && fixType >= 2 && fixType <= 4;   // 2D, 3D, GNSS + dead reckoning
+    fix_.sats = p[23];
+    if (fix_.fix) {
+        fix_.lon = GetI32(p + 24) * 1e-7;
+        fix_.lat = GetI32(p + 28) * 1e-7;
+        fix_.alt = static_cast<float>(GetI32(p + 36)) * 1e-3f;  // hMSL, mm
+    }
+    return Publish();
+}
+
+size_t GnssParser::Publish() {
+    fix_.ms = static_cast<uint32_t>(Rtos::NowUs() / 1000);
+    stats_.fixes++;
+    if (!sink_(fix_, ctx_)) stats_.sinkDrops++;
+    return 1;
+}
+
+uint8_t GnssParser::NmeaChecksum(const char* body, size_t len) {
+    uint8_t sum = 0;
+    for (size_t i = 0; i < len; ++i) sum ^= static_cast<uint8_t>(body[i]);
+    return sum;
+}
+
+size_t GnssParser::EncodeUbx(uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t len, uint8_t* out) {
+    out[0] = UBX_SYNC_0;
+    out[1] = UBX_SYNC_1;
+    out[2] = cls;
+    out[3] = id;
+    out[4] = static_cast<uint8_t>(len);
+    out[5] = static_cast<uint8_t>(len >> 8);
+    std::memcpy(out + 6, payload, len);
+    uint8_t a = 0, b = 0;
+    for (size_t i = 2; i < 6u + len; ++i) {
+        a += out[i];
+        b += a;
+    }
+    out[6 + len] = a;
+    out[7 + len] = b;
+    return 8u + len;
+}
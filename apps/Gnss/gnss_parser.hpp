@@ -0,0 +1,103 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "msg/messages.hpp"
+
+// Streaming GNSS receiver decoder (NMEA 0183 GGA/RMC and UBX-NAV-PVT)
+//
+// Consumes the receiver's serial stream in chunks of any size, where text
+// NMEA sentences and binary UBX frames may be interleaved:
+//
+//   $<talker><type>,<field>,...*<xor checksum, 2 hex>\r\n
+//   | 0xB5 0x62 | class | id | len (u16 LE) | payload | ck_a ck_b |
+//
+// NMEA sentences are buffered and split on commas in place: fields are
+// (pointer, length) views into the line buffer, never copied, and numbers
+// are parsed as scaled integers (coordinates in 1e-7 degrees) without
+// sscanf, strtod or std::string. UBX frames are checked with the 8-bit
+// Fletcher checksum; NAV-PVT is decoded, other messages are skipped.
+//
+// One msg::gnss is published per epoch from the best source seen so far:
+// NAV-PVT, else GGA, else RMC. While a better source keeps arriving the
+// weaker sentences are only counted as ignored; once it has been silent
+// for SOURCE_TIMEOUT_MS (output reconfigured, binary port lost) the next
+// best one takes over again. ms is the local receive time, as for uplink
+// commands.
+class GnssParser {
+    public:
+        static constexpr size_t MAX_SENTENCE_LEN = 96;     // NMEA allows 82, some receivers exceed it
+        static constexpr size_t MAX_FIELDS = 24;
+        static constexpr uint8_t UBX_SYNC_0 = 0xB5;
+        static constexpr uint8_t UBX_SYNC_1 = 0x62;
+        static constexpr uint8_t UBX_CLASS_NAV = 0x01;
+        static constexpr uint8_t UBX_ID_NAV_PVT = 0x07;
+        static constexpr size_t NAV_PVT_LEN = 92;
+        static constexpr uint32_t SOURCE_TIMEOUT_MS = 2000;  // Two missed epochs at 1 Hz
+        static constexpr int MAX_INT_DIGITS = 9;             // Longer numbers are rejected, not overflowed
+
+        // Called for every decoded fix, returns false if it was dropped
+        using Sink = bool (*)(const msg::gnss& g, void* ctx);
+
+        struct Stats {
+            uint32_t sentences;       // NMEA sentences with a valid checksum
+            uint32_t fixes;           // msg::gnss published
+            uint32_t checksumErrors;  // NMEA and UBX
+            uint32_t overflows;       // Sentences longer than MAX_SENTENCE_LEN
+            uint32_t ignored;         // Valid but unused sentences / UBX messages
+            uint32_t sinkDrops;
+        };
+
+        // Default sink publishes on the GNSS topic without blocking
+        GnssParser();
+        GnssParser(Sink sink, void* ctx);
+
+        // Feeds a chunk of bytes, returns the number of fixes published
+        size_t Feed(const uint8_t* data, size_t len);
+        void Reset();
+
+        const Stats& GetStats() const { return stats_; }
+        const msg::gnss& LastFix() const { return fix_; }
+
+        // Helpers for building test streams
+        static uint8_t NmeaChecksum(const char* body, size_t len);   // XOR of the bytes between $ and *
+        static size_t EncodeUbx(uint8_t cls, uint8_t id, const uint8_t* payload, uint16_t len, uint8_t* out);
+
+    private:
+        enum class State : uint8_t { IDLE, NMEA, UBX_SYNC_1, UBX_HEADER, UBX_PAYLOAD, UBX_CK_A, UBX_CK_B };
+
+        // Zero-copy view of one comma-separated field
+        struct Field {
+            const char* p;
+            uint8_t len;
+        };
+
+        size_t Step(uint8_t byte);
+        size_t EndSentence();
+        size_t EndUbx();
+        size_t HandleGga(const Field* f, size_t n);
+        size_t HandleRmc(const Field* f, size_t n);
+        size_t Publish();
+
+        static bool ParseUInt(const Field& f, uint32_t& out);
+        static bool ParseFixed(const Field& f, int decimals, int64_t& out);
+        static bool ParseCoordinate(const Field& value, const Field& hemi, int32_t& e7);
+
+        Sink sink_;
+        void* ctx_;
+        State state_ = State::IDLE;
+
+        char line_[MAX_SENTENCE_LEN];
+        size_t lineLen_ = 0;
+        uint8_t xor_ = 0;              // Running NMEA checksum over line_
+
+        uint8_t ubxHeader_[4];         // class, id, len lo, len hi
+        uint8_t ubxPayload_[NAV_PVT_LEN];
+        size_t ubxPos_ = 0;
+        uint16_t ubxLen_ = 0;
+        uint8_t ckA_ = 0, ckB_ = 0;
+
+        uint64_t ggaUntilUs_ = 0;      // GGA preferred over RMC until then
+        uint64_t pvtUntilUs_ = 0;      // NAV-PVT preferred over NMEA until then
+        msg::gnss fix_ = {};
+        Stats stats_ = {};
+};
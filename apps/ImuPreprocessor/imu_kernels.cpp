@@ -0,0 +1,181 @@
+#include "apps/ImuPreprocessor/imu_kernels.hpp"
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#define IMU_KERNELS_AVX
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define IMU_KERNELS_SSE2
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#define IMU_KERNELS_NEON
+#endif
+
+//== Scalar reference ==//
+void ImuKernels::Scalar::Calibrate3(float* x, float* y, float* z, size_t n,
+                                    const float M[3][3], const float bias[3]) {
+    for (size_t i = 0; i < n; ++i) {
+        const float dx = x[i] - bias[0];
+        const float dy = y[i] - bias[1];
+        const float dz = z[i] - bias[2];
+        x[i] = M[0][0] * dx + M[0][1] * dy + M[0][2] * dz;
+        y[i] = M[1][0] * dx + M[1][1] * dy + M[1][2] * dz;
+        z[i] = M[2][0] * dx + M[2][1] * dy + M[2][2] * dz;
+    }
+}
+
+float ImuKernels::Scalar::Dot(const float* a, const float* b, size_t n) {
+    float s = 0.0f;
+    for (size_t i = 0; i < n; ++i) s += a[i] * b[i];
+    return s;
+}
+
+//== AVX ==//
+#if defined(IMU_KERNELS_AVX)
+
+static inline __m256 MulAdd(__m256 a, __m256 b, __m256 c) {
+#if defined(__FMA__)
+    return _mm256_fmadd_ps(a, b, c);
+#else
+    return _mm256_add_ps(_mm256_mul_ps(a, b), c);
+#endif
+}
+
+const char* ImuKernels::Isa() { return "avx"; }
+
+void ImuKernels::Calibrate3(float* x, float* y, float* z, size_t n,
+                            const float M[3][3], const float bias[3]) {
+    const __m256 bx = _mm256_set1_ps(bias[0]), by = _mm256_set1_ps(bias[1]), bz = _mm256_set1_ps(bias[2]);
+    __m256 m[3][3];
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 3; ++c) m[r][c] = _mm256_set1_ps(M[r][c]);
+
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        const __m256 dx = _mm256_sub_ps(_mm256_loadu_ps(x + i), bx);
+        const __m256 dy = _mm256_sub_ps(_mm256_loadu_ps(y + i), by);
+        const __m256 dz = _mm256_sub_ps(_mm256_loadu_ps(z + i), bz);
+        _mm256_storeu_ps(x + i, MulAdd(m[0][2], dz, MulAdd(m[0][1], dy, _mm256_mul_ps(m[0][0], dx))));
+        _mm256_storeu_ps(y + i, MulAdd(m[1][2], dz, MulAdd(m[1][1], dy, _mm256_mul_ps(m[1][0], dx))));
+        _mm256_storeu_ps(z + i, MulAdd(m[2][2], dz, MulAdd(m[2][1], dy, _mm256_mul_ps(m[2][0], dx))));
+    }
+    Scalar::Calibrate3(x + i, y + i, z + i, n - i, M, bias);
+}
+
+float ImuKernels::Dot(const float* a, const float* b, size_t n) {
+    // Two accumulators hide the add latency
+    __m256 acc0 = _mm256_setzero_ps(), acc1 = _mm256_setzero_ps();
+    size_t i = 0;
+    for (; i + 16 <= n; i += 16) {
+        acc0 = MulAdd(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        acc1 = MulAdd(_mm256_loadu_ps(a + i + 8), _mm256_loadu_ps(b + i + 8), acc1);
+    }
+    if (i + 8 <= n) {
+        acc0 = MulAdd(_mm256_loadu_ps(a + i), _mm256_loadu_ps(b + i), acc0);
+        i += 8;
+    }
+    const __m256 acc = _mm256_add_ps(acc0, acc1);
+    __m128 s = _mm_add_ps(_mm256_castps256_ps128(acc), _mm256_extractf128_ps(acc, 1));
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s) + Scalar::Dot(a + i, b + i, n - i);
+}
+
+//== SSE2 ==//
+#elif defined(IMU_KERNELS_SSE2)
+
+const char* ImuKernels::Isa() { return "sse2"; }
+
+void ImuKernels::Calibrate3(float* x, float* y, float* z, size_t n,
+                            const float M[3][3], const float bias[3]) {
+    const __m128 bx = _mm_set1_ps(bias[0]), by = _mm_set1_ps(bias[1]), bz = _mm_set1_ps(bias[2]);
+    __m128 m[3][3];
+    for (int r = 0; r < 3; ++r)
+        for (int c = 0; c < 3; ++c) m[r][c] = _mm_set1_ps(M[r][c]);
+
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 dx = _mm_sub_ps(_mm_loadu_ps(x + i), bx);
+        const __m128 dy = _mm_sub_ps(_mm_loadu_ps(y + i), by);
+        const __m128 dz = _mm_sub_ps(_mm_loadu_ps(z + i), bz);
+        for (int r = 0; r < 3; ++r) {
+            __m128 v = _mm_add_ps(_mm_add_ps(_mm_mul_ps(m[r][0], dx), _mm_mul_ps(m[r][1], dy)),
+                                  _mm_mul_ps(m[r][2], dz));
+            _mm_storeu_ps((r == 0 ? x : r == 1 ? y : z) + i, v);
+        }
+    }
+    Scalar::Calibrate3(x + i, y + i, z + i, n - i, M, bias);
+}
+
+float ImuKernels::Dot(const float* a, const float* b, size_t n) {
+    __m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(a + i + 4), _mm_loadu_ps(b + i + 4)));
+    }
+    if (i + 4 <= n) {
+        acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+        i += 4;
+    }
+    __m128 s = _mm_add_ps(acc0, acc1);
+    s = _mm_add_ps(s, _mm_movehl_ps(s, s));
+    s = _mm_add_ss(s, _mm_shuffle_ps(s, s, 1));
+    return _mm_cvtss_f32(s) + Scalar::Dot(a + i, b + i, n - i);
+}
+
+//== NEON ==//
+#elif defined(IMU_KERNELS_NEON)
+
+const char* ImuKernels::Isa() { return "neon"; }
+
+void ImuKernels::Calibrate3(float* x, float* y, float* z, size_t n,
+                            const float M[3][3], const float bias[3]) {
+    const float32x4_t bx = vdupq_n_f32(bias[0]), by = vdupq_n_f32(bias[1]), bz = vdupq_n_f32(bias[2]);
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t dx = vsubq_f32(vld1q_f32(x + i), bx);
+        const float32x4_t dy = vsubq_f32(vld1q_f32(y + i), by);
+        const float32x4_t dz = vsubq_f32(vld1q_f32(z + i), bz);
+        for (int r = 0; r < 3; ++r) {
+            float32x4_t v = vmulq_n_f32(dx, M[r][0]);
+            v = vmlaq_n_f32(v, dy, M[r][1]);
+            v = vmlaq_n_f32(v, dz, M[r][2]);
+            vst1q_f32((r == 0 ? x : r == 1 ? y : z) + i, v);
+        }
+    }
+    Scalar::Calibrate3(x + i, y + i, z + i, n - i, M, bias);
+}
+
+float ImuKernels::Dot(const float* a, const float* b, size_t n) {
+    float32x4_t acc0 = vdupq_n_f32(0.0f), acc1 = vdupq_n_f32(0.0f);
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        acc1 = vmlaq_f32(acc1, vld1q_f32(a + i + 4), vld1q_f32(b + i + 4));
+    }
+    if (i + 4 <= n) {
+        acc0 = vmlaq_f32(acc0, vld1q_f32(a + i), vld1q_f32(b + i));
+        i += 4;
+    }
+    const float32x4_t acc = vaddq_f32(acc0, acc1);
+    // Lane sum that also builds for 32-bit ARM (no vaddvq_f32)
+    const float32x2_t s = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+    return vget_lane_f32(vpadd_f32(s, s), 0) + Scalar::Dot(a + i, b + i, n - i);
+}
+
+//== Scalar fallback ==//
+#else
+
+const char* ImuKernels::Isa() { return "scalar"; }
+
+void ImuKernels::Calibrate3(float* x, float* y, float* z, size_t n,
+                            const float M[3][3], const float bias[3]) {
+    Scalar::Calibrate3(x, y, z, n, M, bias);
+}
+
+float ImuKernels::Dot(const float* a, const float* b, size_t n) {
+    return Scalar::Dot(a, b, n);
+}
+
+#endif
@@ -0,0 +1,28 @@
+#pragma once
+#include <cstddef>
+
+// Vector kernels for the IMU preprocessing stage
+//
+// All kernels work on structure-of-arrays data (one contiguous float array
+// per axis). The instruction set is picked at compile time from the
+// compiler's target macros: AVX (with FMA if available), SSE2, NEON, or
+// plain scalar code. The Scalar namespace always holds the reference
+// implementations so the vector paths can be checked against them.
+namespace ImuKernels {
+
+    // Name of the compiled-in kernel set ("avx", "sse2", "neon", "scalar")
+    const char* Isa();
+
+    // In place: v = M * (v - bias) for the 3-axis vectors (x[i], y[i], z[i])
+    void Calibrate3(float* x, float* y, float* z, size_t n,
+                    const float M[3][3], const float bias[3]);
+
+    // sum(a[i] * b[i]) for i < n, no alignment requirement
+    float Dot(const float* a, const float* b, size_t n);
+
+    namespace Scalar {
+        void Calibrate3(float* x, float* y, float* z, size_t n,
+                        const float M[3][3], const float bias[3]);
+        float Dot(const float* a, const float* b, size_t n);
+    }
+}
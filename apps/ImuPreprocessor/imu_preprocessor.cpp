@@ -0,0 +1,115 @@
+#include "apps/ImuPreprocessor/imu_preprocessor.hpp"
+#include "apps/ImuPreprocessor/imu_kernels.hpp"
+#include "queues/queues.hpp"
+#include "os/rtos.hpp"
+
+#include <cmath>
+#include <cstring>
+
+ImuPreprocessor::ImuPreprocessor(unsigned decimation, size_t taps, const ImuCalibration& calibration)
+    : cal_(calibration),
+      decimation_(decimation == 0 ? 1 : decimation),
+      taps_(taps == 0 ? 1 : taps > MAX_TAPS ? MAX_TAPS : taps) {
+    // Hamming-windowed sinc, cutoff at 80% of the output Nyquist frequency
+    const double pi = 3.14159265358979323846;
+    const double fc = 0.8 * 0.5 / decimation_;   // cycles per input sample
+    const double mid = (taps_ - 1) / 2.0;
+    double sum = 0.0;
+    for (size_t t = 0; t < taps_; ++t) {
+        const double k = t - mid;
+        const double sinc = k == 0.0 ? 2.0 * fc : std::sin(2.0 * pi * fc * k) / (pi * k);
+        const double window = taps_ > 1 ? 0.54 - 0.46 * std::cos(2.0 * pi * t / (taps_ - 1)) : 1.0;
+        coeffs_[t] = static_cast<float>(sinc * window);
+        sum += coeffs_[t];
+    }
+    for (size_t t = 0; t < taps_; ++t) coeffs_[t] = static_cast<float>(coeffs_[t] / sum);  // Unity DC gain
+    for (size_t t = taps_; t < MAX_TAPS; ++t) coeffs_[t] = 0.0f;
+    Reset();
+}
+
+void ImuPreprocessor::Reset() {
+    std::memset(hist_, 0, sizeof(hist_));
+    phase_ = 0;
+    primed_ = false;
+}
+
+size_t ImuPreprocessor::Process(const msg::imu* in, size_t n, msg::imu* out, size_t outCapacity) {
+    // Largest input whose outputs still fit: (phase + n) / decimation <= capacity
+    const size_t maxIn = (outCapacity + 1) * decimation_ - 1 - phase_;
+    if (n > maxIn) n = maxIn;
+
+    size_t written = 0;
+    while (n > 0) {
+        const size_t chunk = n < BATCH ? n : BATCH;
+        written += ProcessBatch(in, chunk, out + written);
+        in += chunk;
+        n -= chunk;
+    }
+    return written;
+}
+
+size_t ImuPreprocessor::ProcessBatch(const msg::imu* in, size_t n, msg::imu* out) {
+    const size_t base = taps_ - 1;
+
+    // AoS -> SoA
+    for (size_t k = 0; k < n; ++k) {
+        hist_[0][base + k] = in[k].ax;
+        hist_[1][base + k] = in[k].ay;
+        hist_[2][base + k] = in[k].az;
+        hist_[3][base + k] = in[k].gx;
+        hist_[4][base + k] = in[k].gy;
+        hist_[5][base + k] = in[k].gz;
+    }
+
+    ImuKernels::Calibrate3(hist_[0] + base, hist_[1] + base, hist_[2] + base, n,
+                           cal_.accelMatrix, cal_.accelBias);
+    ImuKernels::Calibrate3(hist_[3] + base, hist_[4] + base, hist_[5] + base, n,
+                           cal_.gyroMatrix, cal_.gyroBias);
+
+    // Start from a settled filter instead of ramping up from zero
+    if (!primed_) {
+        for (size_t ch = 0; ch < CHANNELS; ++ch)
+            for (size_t t = 0; t < base; ++t) hist_[ch][t] = hist_[ch][base];
+        primed_ = true;
+    }
+
+    // The window for the sample at base + k starts at k
+    size_t written = 0;
+    for (size_t k = 0; k < n; ++k) {
+        if (++phase_ < decimation_) continue;
+        phase_ = 0;
+        msg::imu& o = out[written++];
+        o.ax = ImuKernels::Dot(coeffs_, hist_[0] + k, taps_);
+        o.ay = ImuKernels::Dot(coeffs_, hist_[1] + k, taps_);
+        o.az = ImuKernels::Dot(coeffs_, hist_[2] + k, taps_);
+        o.gx = ImuKernels::Dot(coeffs_, hist_[3] + k, taps_);
+        o.gy = ImuKernels::Dot(coeffs_, hist_[4] + k, taps_);
+        o.gz = ImuKernels::Dot(coeffs_, hist_[5] + k, taps_);
+        o.ms = in[k].ms;
+    }
+
+    // Keep the newest taps-1 samples as history for the next batch
+    for (size_t ch = 0; ch < CHANNELS; ++ch) {
+        std::memmove(hist_[ch], hist_[ch] + n, base * sizeof(float));
+    }
+    return written;
+}
+
+void ImuPreprocessor::Run(void*) {
+    static ImuPreprocessor pre;
+    static msg::imu raw[BATCH];
+    static msg::imu filtered[BATCH / DECIMATION + 1];
+    Bus::Subscription<Topics::RAW_IMU> input;
+
+    while(true) {
+        // Block for one sample, then take whatever else has arrived as the batch
+        if (!input.receive(raw[0])) continue;
+        size_t n = 1;
+        while (n < BATCH && input.try_receive(raw[n])) n++;
+
+        size_t m = pre.Process(raw, n, filtered, sizeof(filtered) / sizeof(filtered[0]));
+        for (size_t i = 0; i < m; ++i) {
+            Bus::Publish<Topics::IMU>(filtered[i]);
+        }
+    }
+}
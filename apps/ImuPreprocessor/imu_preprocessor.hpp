@@ -0,0 +1,61 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "msg/messages.hpp"
+
+// Per-sensor calibration: v_cal = M * (v_raw - bias). M folds scale
+// factors and axis misalignment into one 3x3 matrix.
+struct ImuCalibration {
+    float accelBias[3] = {0.0f, 0.0f, 0.0f};
+    float accelMatrix[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+    float gyroBias[3] = {0.0f, 0.0f, 0.0f};
+    float gyroMatrix[3][3] = {{1.0f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, {0.0f, 0.0f, 1.0f}};
+};
+
+// IMU preprocessing stage: raw high-rate samples -> calibrated, low-pass
+// filtered, decimated samples at estimator rate.
+//
+// Samples are gathered into structure-of-arrays batches (one array per
+// axis) so calibration and filtering run as vector kernels over many
+// samples at once (see imu_kernels.hpp). The decimator is a linear-phase
+// windowed-sinc FIR that only evaluates the outputs it keeps, i.e. the
+// polyphase cost of taps/decimation MACs per input sample per axis.
+// Outputs lag the input by (taps - 1) / 2 raw samples; ms is that of the
+// newest raw sample.
+class ImuPreprocessor {
+    public:
+        static constexpr size_t CHANNELS = 6;        // ax ay az gx gy gz
+        static constexpr size_t MAX_TAPS = 64;
+        static constexpr size_t BATCH = 64;          // Raw samples per SoA batch
+        static constexpr unsigned RAW_RATE_HZ = 4000;
+        static constexpr unsigned DECIMATION = 4;    // 4 kHz -> 1 kHz on the IMU topic
+        static constexpr size_t TAPS = 32;
+
+        ImuPreprocessor(unsigned decimation = DECIMATION, size_t taps = TAPS,
+                        const ImuCalibration& calibration = {});
+
+        void SetCalibration(const ImuCalibration& calibration) { cal_ = calibration; }
+        void Reset();
+
+        // Filters in[0..n) and writes one sample per `decimation` inputs to
+        // out. out must hold n / decimation + 1 samples; input that would
+        // not fit is not consumed. Returns the number of samples written.
+        size_t Process(const msg::imu* in, size_t n, msg::imu* out, size_t outCapacity);
+
+        const float* Taps() const { return coeffs_; }
+        size_t NumTaps() const { return taps_; }
+        unsigned Decimation() const { return decimation_; }
+
+        static void Run(void* args); //Rtos task entry point (RAW_IMU -> IMU topic)
+
+    private:
+        size_t ProcessBatch(const msg::imu* in, size_t n, msg::imu* out);
+
+        ImuCalibration cal_;
+        unsigned decimation_;
+        size_t taps_;
+        unsigned phase_ = 0;
+        bool primed_ = false;
+        alignas(32) float coeffs_[MAX_TAPS];
+        alignas(32) float hist_[CHANNELS][MAX_TAPS - 1 + BATCH];  // Taps-1 old samples, then the batch
+};
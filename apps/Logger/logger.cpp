@@ -0,0 +1,229 @@
+#include "apps/Logger/logger.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+
+//== Per-task rings ==//
+
+struct Ring {
+    Rtos::SpscQueue<Logger::Record, Logger::RING_DEPTH> queue;
+    std::atomic<bool> used{false};
+    std::atomic<uint64_t> dropped{0};   // Only the owning task adds
+
+    // Drain side only
+    Logger::Record head;                // Oldest record, taken out for the merge
+    bool hasHead = false;
+    uint64_t reported = 0;              // Drops already reported
+};
+
+static Ring g_rings[Logger::MAX_RINGS];
+static std::atomic<uint64_t> g_noRing{0};     // Records from tasks that found no free ring
+static uint64_t g_noRingReported = 0;
+
+// Claims a ring on a task's first log call and hands it back when the task
+// exits. Records still queued stay in order: the next owner appends after them.
+struct RingOwner {
+    Ring* ring = nullptr;
+    bool tried = false;
+
+    Ring* Get() {
+        if (!tried) {
+            tried = true;
+            for (Ring& r : g_rings) {
+                bool expected = false;
+                if (r.used.compare_exchange_strong(expected, true, std::memory_order_acquire)) {
+                    ring = &r;
+                    break;
+                }
+            }
+        }
+        return ring;
+    }
+
+    ~RingOwner() {
+        if (ring) ring->used.store(false, std::memory_order_release);
+    }
+};
+
+static thread_local RingOwner t_owner;
+
+//== Drain state ==//
+
+static void StdoutSink(const char* line, size_t len) {
+    std::fwrite(line, 1, len, stdout);
+    std::fputc('\n', stdout);
+}
+
+static Rtos::Mutex g_drainLock;                // Serialises the drain task and Flush()
+static std::atomic<Logger::Sink> g_sink{StdoutSink};
+static std::atomic<uint8_t> g_minLevel{Logger::DEBUG};
+static std::atomic<uint64_t> g_written{0};
+
+//== Hot path ==//
+
+Logger::Level Logger::MinLevel() {
+    return static_cast<Level>(g_minLevel.load(std::memory_order_relaxed));
+}
+
+void Logger::Push(const Record& r) {
+    Ring* ring = t_owner.Get();
+    if (!ring) {
+        g_noRing.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    if (!ring->queue.try_send(r)) ring->dropped.fetch_add(1, std::memory_order_relaxed);
+}
+
+//== Formatting ==//
+
+// Rewrites one conversion for the type actually stored, so a mismatched
+// format string prints something odd instead of reading the wrong type.
+static int FormatArg(char* out, size_t cap, char* spec, size_t specLen, char conv,
+                     const Logger::Record::Arg& a, Logger::ArgType type) {
+    auto finish = [&](const char* suffix) {
+        std::strcpy(spec + specLen, suffix);
+        return spec;
+    };
+    switch (type) {
+        case Logger::INT:
+            if (conv == 'c') return std::snprintf(out, cap, finish("c"), static_cast<int>(a.i));
+            if (std::strchr("eEfFgGaA", conv)) return std::snprintf(out, cap, finish("g"), static_cast<double>(a.i));
+            if (std::strchr("ouxX", conv)) return std::snprintf(out, cap, finish(conv == 'o' ? "llo" : conv == 'u' ? "llu" : conv == 'x' ? "llx" : "llX"), static_cast<unsigned long long>(a.i));
+            return std::snprintf(out, cap, finish("lld"), static_cast<long long>(a.i));
+        case Logger::UINT:
+            if (conv == 'c') return std::snprintf(out, cap, finish("c"), static_cast<int>(a.u));
+            if (std::strchr("eEfFgGaA", conv)) return std::snprintf(out, cap, finish("g"), static_cast<double>(a.u));
+            if (std::strchr("oxX", conv)) return std::snprintf(out, cap, finish(conv == 'o' ? "llo" : conv == 'x' ? "llx" : "llX"), static_cast<unsigned long long>(a.u));
+            return std::snprintf(out, cap, finish("llu"), static_cast<unsigned long long>(a.u));
+        case Logger::DOUBLE: {
+            const char d[2] = {std::strchr("eEfFgGaA", conv) ? conv : 'g', '\0'};
+            return std::snprintf(out, cap, finish(d), a.d);
+        }
+        case Logger::STR:
+            return std::snprintf(out, cap, finish("s"), a.s ? a.s : "(null)");
+        case Logger::PTR:
+            return std::snprintf(out, cap, finish("p"), a.p);
+    }
+    return 0;
+}
+
+size_t Logger::Format(const Record& r, char* out, size_t cap) {
+    if (cap == 0) return 0;
+    static const char* const PREFIX[] = {"", "", "WARN: ", "ERROR: "};
+    size_t len = 0;
+    auto append = [&](int n) {
+        if (n > 0) len = (len + n < cap) ? len + n : cap - 1;
+    };
+
+    append(std::snprintf(out, cap, "%s", PREFIX[r.level]));
+    int arg = 0;
+    const char* p = r.fmt;
+    while (*p && len + 1 < cap) {
+        if (*p != '%') {
+            out[len++] = *p++;
+            continue;
+        }
+        if (p[1] == '%') {
+            out[len++] = '%';
+            p += 2;
+            continue;
+        }
+
+        // Keep flags, width and precision; length modifiers come from the stored type
+        const char* start = p;
+        char spec[24];
+        size_t specLen = 0;
+        spec[specLen++] = *p++;
+        while (*p && std::strchr("-+ #0123456789.", *p) && specLen < sizeof(spec) - 4) spec[specLen++] = *p++;
+        while (*p && std::strchr("hlLqjzt", *p)) p++;
+        const char conv = *p;
+        if (conv == '\0' || !std::strchr("diouxXcfFeEgGaAsp", conv) || arg >= r.count) {
+            // Malformed, unsupported or missing argument: copy the text as is
+            const size_t n = (conv ? p + 1 : p) - start;
+            for (size_t i = 0; i < n && len + 1 < cap; ++i) out[len++] = start[i];
+            if (conv) p++;
+            continue;
+        }
+        p++;
+        append(FormatArg(out + len, cap - len, spec, specLen, conv, r.args[arg], r.types[arg]));
+        arg++;
+    }
+    out[len] = '\0';
+    return len;
+}
+
+//== Drain ==//
+
+static void Report(Logger::Sink sink, uint64_t lost) {
+    char line[64];
+    const int n = std::snprintf(line, sizeof(line), "[Logger] %llu records dropped",
+                                static_cast<unsigned long long>(lost));
+    sink(line, static_cast<size_t>(n));
+}
+
+// Merges the rings by timestamp, so lines from different tasks come out
+// in the order they were logged. Bounded per call so a busy producer
+// cannot keep the drain going forever.
+static void DrainAll() {
+    const Logger::Sink sink = g_sink.load(std::memory_order_acquire);
+    char line[Logger::MAX_LINE];
+
+    g_drainLock.lock();
+    for (size_t budget = Logger::MAX_RINGS * Logger::RING_DEPTH; budget > 0; --budget) {
+        Ring* oldest = nullptr;
+        for (Ring& ring : g_rings) {
+            if (!ring.hasHead) ring.hasHead = ring.queue.try_receive(ring.head);
+            if (ring.hasHead && (!oldest || ring.head.us < oldest->head.us)) oldest = &ring;
+        }
+        if (!oldest) break;
+        sink(line, Logger::Format(oldest->head, line, sizeof(line)));
+        oldest->hasHead = false;
+        g_written.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    for (Ring& ring : g_rings) {
+        const uint64_t dropped = ring.dropped.load(std::memory_order_relaxed);
+        if (dropped != ring.reported) {
+            Report(sink, dropped - ring.reported);
+            ring.reported = dropped;
+        }
+    }
+    const uint64_t noRing = g_noRing.load(std::memory_order_relaxed);
+    if (noRing != g_noRingReported) {
+        Report(sink, noRing - g_noRingReported);
+        g_noRingReported = noRing;
+    }
+    g_drainLock.unlock();
+}
+
+//== Public API ==//
+
+void Logger::SetSink(Sink sink) {
+    g_sink.store(sink ? sink : StdoutSink, std::memory_order_release);
+}
+
+void Logger::SetLevel(Level min) {
+    g_minLevel.store(min, std::memory_order_relaxed);
+}
+
+void Logger::Flush() {
+    DrainAll();
+}
+
+uint64_t Logger::Dropped() {
+    uint64_t total = g_noRing.load(std::memory_order_relaxed);
+    for (const Ring& ring : g_rings) total += ring.dropped.load(std::memory_order_relaxed);
+    return total;
+}
+
+uint64_t Logger::Written() {
+    return g_written.load(std::memory_order_relaxed);
+}
+
+void Logger::Run(void*) {
+    for (;;) {
+        Rtos::SleepMs(Logger::DRAIN_PERIOD_MS);
+        DrainAll();
+    }
+}
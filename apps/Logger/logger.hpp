@@ -0,0 +1,122 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "os/rtos.hpp"
+
+// Deferred binary logger
+//
+// A log call does no formatting and no I/O: it copies the format string
+// pointer, a timestamp and the raw argument values into a fixed-size
+// record and pushes it into the calling task's own SPSC ring. Each task
+// claims a ring on its first log call, so producers never share a cache
+// line or take a lock. The low-priority Logger task drains every ring on
+// a short period, formats with printf rules and hands lines to the sink.
+//
+// When a ring is full the record is dropped and counted; the drain task
+// reports the losses. Format strings must be literals, and %s arguments
+// must outlive the drain (string literals, static tables).
+//
+//   Logger::Info("[StateMachine] %s -> %s", StateName(from), StateName(to));
+class Logger {
+    public:
+        enum Level : uint8_t { DEBUG, INFO, WARN, ERROR };
+
+        static constexpr int MAX_ARGS = 6;
+        static constexpr int MAX_RINGS = 16;          // Tasks that may log
+        static constexpr size_t RING_DEPTH = 128;     // Records per task
+        static constexpr uint32_t DRAIN_PERIOD_MS = 10;
+        static constexpr size_t MAX_LINE = 256;
+
+        // Receives one formatted line (no trailing newline)
+        using Sink = void (*)(const char* line, size_t len);
+
+        enum ArgType : uint8_t { INT, UINT, DOUBLE, STR, PTR };
+
+        // One log call, as it sits in the ring: plain data, copied by value
+        struct Record {
+            const char* fmt;
+            uint64_t us;
+            union Arg {
+                int64_t i;
+                uint64_t u;
+                double d;
+                const char* s;
+                const void* p;
+            } args[MAX_ARGS];
+            ArgType types[MAX_ARGS];
+            uint8_t count;
+            Level level;
+        };
+
+        //-- Hot path --//
+        template <typename... Args>
+        static void Debug(const char* fmt, const Args&... args) { Write(DEBUG, fmt, args...); }
+        template <typename... Args>
+        static void Info(const char* fmt, const Args&... args) { Write(INFO, fmt, args...); }
+        template <typename... Args>
+        static void Warn(const char* fmt, const Args&... args) { Write(WARN, fmt, args...); }
+        template <typename... Args>
+        static void Error(const char* fmt, const Args&... args) { Write(ERROR, fmt, args...); }
+
+        template <typename... Args>
+        static void Write(Level level, const char* fmt, const Args&... args) {
+            static_assert(sizeof...(Args) <= MAX_ARGS, "too many log arguments");
+            if (level < MinLevel()) return;
+            Record r;
+            r.fmt = fmt;
+            r.us = Rtos::NowUs();
+            r.level = level;
+            r.count = 0;
+            (Pack(r, args), ...);
+            Push(r);
+        }
+
+        //-- Setup and drain side --//
+        static void SetSink(Sink sink);          // Default: stdout
+        static void SetLevel(Level min);         // Default: DEBUG
+
+        // Formats and writes everything logged so far; safe from any task
+        static void Flush();
+
+        static uint64_t Dropped();               // Records lost to full rings, all tasks
+        static uint64_t Written();               // Lines handed to the sink
+
+        // Formats one record into out (always terminated), returns its length
+        static size_t Format(const Record& r, char* out, size_t cap);
+
+        static void Run(void* args); //Rtos task entry point (drains every DRAIN_PERIOD_MS)
+
+    private:
+        static Level MinLevel();
+        static void Push(const Record& r);
+
+        template <typename T>
+        static void Pack(Record& r, const T& v) {
+            Record::Arg& a = r.args[r.count];
+            if constexpr (std::is_same<T, bool>::value) {
+                a.i = v;
+                r.types[r.count] = INT;
+            } else if constexpr (std::is_enum<T>::value) {
+                a.i = static_cast<int64_t>(v);
+                r.types[r.count] = INT;
+            } else if constexpr (std::is_integral<T>::value && std::is_signed<T>::value) {
+                a.i = v;
+                r.types[r.count] = INT;
+            } else if constexpr (std::is_integral<T>::value) {
+                a.u = v;
+                r.types[r.count] = UINT;
+            } else if constexpr (std::is_floating_point<T>::value) {
+                a.d = v;
+                r.types[r.count] = DOUBLE;
+            } else if constexpr (std::is_convertible<T, const char*>::value) {
+                a.s = v;
+                r.types[r.count] = STR;
+            } else {
+                static_assert(std::is_pointer<T>::value, "log arguments must be numbers, enums, strings or pointers");
+                a.p = v;
+                r.types[r.count] = PTR;
+            }
+            r.count++;
+        }
+};
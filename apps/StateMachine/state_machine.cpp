@@ -0,0 +1,173 @@
+#include "apps/StateMachine/state_machine.hpp"
+#include "apps/Logger/logger.hpp"
+#include "queues/queues.hpp"
+#include "os/rtos.hpp"
+
+#include <atomic>
+
+using State = StateMachine::State;
+using Event = StateMachine::Event;
+
+static std::atomic<uint8_t> g_state{StateMachine::IDLE};
+static std::atomic<bool> g_tx_on{false};
+static Rtos::Mutex g_lock;   // Serialises Post() between CommandHandler and StateMachine tasks
+
+static Rtos::EventGroup g_ready;
+static constexpr uint32_t SUBSCRIBED_BIT = 0x1;
+
+//== Guards and actions ==//
+
+using Guard = bool (*)();
+using Action = void (*)();
+
+static bool TxOff() { return !g_tx_on.load(std::memory_order_relaxed); }
+
+static void TxOn() { g_tx_on.store(true, std::memory_order_relaxed); }
+static void TxOffAction() { g_tx_on.store(false, std::memory_order_relaxed); }
+
+//== Transition table ==//
+
+struct Transition {
+    State from;
+    Event event;
+    State to;
+    Guard guard;    // nullptr: always allowed
+    Action action;  // nullptr: state change only
+};
+
+static constexpr Transition TRANSITIONS[] = {
+    {StateMachine::IDLE,    StateMachine::CMD_ARM,    StateMachine::ARMED,   nullptr, nullptr},
+    {StateMachine::ARMED,   StateMachine::CMD_DISARM, StateMachine::IDLE,    TxOff,   nullptr},
+    {StateMachine::ARMED,   StateMachine::LAUNCH,     StateMachine::ASCENT,  nullptr, nullptr},
+    {StateMachine::ASCENT,  StateMachine::APOGEE,     StateMachine::DESCENT, nullptr, nullptr},
+    {StateMachine::DESCENT, StateMachine::LANDING,    StateMachine::LANDED,  nullptr, TxOn},  // Recovery beacon
+
+    // Transmitter control once armed; the phase does not change
+    {StateMachine::ARMED,   StateMachine::CMD_TX_ON,  StateMachine::ARMED,   nullptr, TxOn},
+    {StateMachine::ASCENT,  StateMachine::CMD_TX_ON,  StateMachine::ASCENT,  nullptr, TxOn},
+    {StateMachine::DESCENT, StateMachine::CMD_TX_ON,  StateMachine::DESCENT, nullptr, TxOn},
+    {StateMachine::LANDED,  StateMachine::CMD_TX_ON,  StateMachine::LANDED,  nullptr, TxOn},
+    {StateMachine::ARMED,   StateMachine::CMD_TX_OFF, StateMachine::ARMED,   nullptr, TxOffAction},
+    {StateMachine::ASCENT,  StateMachine::CMD_TX_OFF, StateMachine::ASCENT,  nullptr, TxOffAction},
+    {StateMachine::DESCENT, StateMachine::CMD_TX_OFF, StateMachine::DESCENT, nullptr, TxOffAction},
+    {StateMachine::LANDED,  StateMachine::CMD_TX_OFF, StateMachine::LANDED,  nullptr, TxOffAction},
+};
+static constexpr size_t NUM_TRANSITIONS = sizeof(TRANSITIONS) / sizeof(TRANSITIONS[0]);
+
+//-- Compile-time checks --//
+
+static constexpr bool RowsInRange() {
+    for (const Transition& t : TRANSITIONS) {
+        if (t.from >= StateMachine::NUM_STATES || t.to >= StateMachine::NUM_STATES) return false;
+        if (t.event >= StateMachine::NUM_EVENTS) return false;
+    }
+    return true;
+}
+
+static constexpr bool NoDuplicateRows() {
+    for (size_t i = 0; i < NUM_TRANSITIONS; ++i)
+        for (size_t j = i + 1; j < NUM_TRANSITIONS; ++j)
+            if (TRANSITIONS[i].from == TRANSITIONS[j].from && TRANSITIONS[i].event == TRANSITIONS[j].event)
+                return false;
+    return true;
+}
+
+static constexpr bool AllStatesReachable() {
+    bool reached[StateMachine::NUM_STATES] = {};
+    reached[StateMachine::IDLE] = true;
+    // Each pass extends the reached set by at least one state, or stops
+    for (size_t pass = 0; pass < StateMachine::NUM_STATES; ++pass)
+        for (const Transition& t : TRANSITIONS)
+            if (reached[t.from]) reached[t.to] = true;
+    for (bool r : reached)
+        if (!r) return false;
+    return true;
+}
+
+static_assert(RowsInRange(), "transition row uses an out-of-range state or event");
+static_assert(NoDuplicateRows(), "two transition rows for the same (state, event)");
+static_assert(AllStatesReachable(), "a state cannot be reached from IDLE");
+
+//-- Dense jump table --//
+
+struct Cell {
+    bool valid;
+    State to;
+    Guard guard;
+    Action action;
+};
+
+struct JumpTable {
+    Cell cells[StateMachine::NUM_STATES][StateMachine::NUM_EVENTS];
+};
+
+static constexpr JumpTable BuildJumpTable() {
+    JumpTable table{};
+    for (const Transition& t : TRANSITIONS) {
+        table.cells[t.from][t.event] = Cell{true, t.to, t.guard, t.action};
+    }
+    return table;
+}
+
+static constexpr JumpTable JUMP = BuildJumpTable();
+
+//== Public API ==//
+
+bool StateMachine::Post(Event event) {
+    if (event >= NUM_EVENTS) return false;
+
+    g_lock.lock();
+    const State from = static_cast<State>(g_state.load(std::memory_order_relaxed));
+    const Cell& cell = JUMP.cells[from][event];
+    bool ok = cell.valid && (!cell.guard || cell.guard());
+    if (ok) {
+        if (cell.action) cell.action();
+        g_state.store(cell.to, std::memory_order_release);
+    }
+    g_lock.unlock();
+
+    if (ok && cell.to != from) {
+        Logger::Info("[StateMachine] %s -> %s", StateName(from), StateName(cell.to));
+    }
+    return ok;
+}
+
+StateMachine::State StateMachine::GetState() {
+    return static_cast<State>(g_state.load(std::memory_order_acquire));
+}
+
+bool StateMachine::IsArmed() {
+    return GetState() != IDLE;
+}
+
+bool StateMachine::IsTxOn() {
+    return g_tx_on.load(std::memory_order_relaxed);
+}
+
+const char* StateMachine::StateName(State s) {
+    static const char* names[NUM_STATES] = {"IDLE", "ARMED", "ASCENT", "DESCENT", "LANDED"};
+    return s < NUM_STATES ? names[s] : "?";
+}
+
+bool StateMachine::WaitSubscribed(int timeout_ms) {
+    return (g_ready.wait(SUBSCRIBED_BIT, false, false, timeout_ms) & SUBSCRIBED_BIT) != 0;
+}
+
+void StateMachine::Run(void*) {
+    static const Event events[] = {LAUNCH, APOGEE, LANDING};  // Indexed by msg::flight_event::Type
+    constexpr size_t NUM_FLIGHT_EVENTS = sizeof(events) / sizeof(events[0]);
+
+    Bus::Subscription<Topics::FLIGHT_EVENT> detector(Bus::Overflow::BACKPRESSURE);  // Never miss one
+    g_ready.set(SUBSCRIBED_BIT);
+
+    while(true) {
+        msg::flight_event e;
+        if (!detector.receive(e, Rtos::MAX_TIMEOUT)) continue;
+        const size_t type = static_cast<size_t>(e.type);
+        if (type >= NUM_FLIGHT_EVENTS) {
+            Logger::Warn("[StateMachine] unknown flight event type %d", static_cast<int>(e.type));
+            continue;
+        }
+        Post(events[type]);
+    }
+}
@@ -1,6 +1,44 @@
 #pragma once
+#include <cstdint>
+#include "msg/messages.hpp"
+#include "os/rtos.hpp"
 
+// Mission state machine
+//
+// Owns the flight phase and the flags derived from it (armed, transmitter
+// on). Transitions come from a constexpr table of (state, event) -> state
+// rows with optional guard and action, which is expanded at compile time
+// into a dense [state][event] jump table: dispatch is one lookup. The
+// table is checked with static_asserts (no duplicate rows, every state
+// reachable from IDLE).
+//
+// Commands reach it through CommandHandler, flight events from the
+// EventDetector through the FLIGHT_EVENT topic.
 class StateMachine {
     public:
-        static void Run(void* args); //Rtos task entry point
-};
\ No newline at end of file
+        enum State : uint8_t { IDLE, ARMED, ASCENT, DESCENT, LANDED, NUM_STATES };
+
+        enum Event : uint8_t {
+            CMD_ARM, CMD_DISARM, CMD_TX_ON, CMD_TX_OFF,   // From CommandHandler
+            LAUNCH, APOGEE, LANDING,                      // From EventDetector
+            NUM_EVENTS
+        };
+
+        // Runs the transition for event in the current state. false if the
+        // table has no row for it or its guard refused; nothing changes then.
+        // Safe to call from any task.
+        static bool Post(Event event);
+
+        static State GetState();
+        static bool IsArmed();     // Any phase after IDLE
+        static bool IsTxOn();
+
+        static const char* StateName(State s);
+
+        // Blocks until the task has subscribed to the FLIGHT_EVENT topic;
+        // call after creating it, before starting the Estimator (whose
+        // EventDetector publishes them), so no event is lost. false on timeout.
+        static bool WaitSubscribed(int timeout_ms = Rtos::MAX_TIMEOUT);
+
+        static void Run(void* args); //Rtos task entry point (FLIGHT_EVENT topic -> Post)
+};
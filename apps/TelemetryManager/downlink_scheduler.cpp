@@ -0,0 +1,131 @@
+#include "apps/TelemetryManager/downlink_scheduler.hpp"
+
+#include <cstring>
+
+DownlinkScheduler::DownlinkScheduler(uint32_t linkBytesPerSec, size_t mtu)
+    : linkBytesPerSec_(linkBytesPerSec), mtu_(mtu < MAX_MESSAGE_LEN ? mtu : MAX_MESSAGE_LEN) {
+    for (size_t c = 0; c < NUM_CLASSES; ++c) {
+        config_[c] = ClassConfig{0, 0, false};  // Unlimited until configured
+        tokens_[c] = 0;
+    }
+}
+
+void DownlinkScheduler::Configure(Class c, const ClassConfig& config) {
+    config_[c] = config;
+    tokens_[c] = static_cast<uint64_t>(config.burstBytes) * 1'000'000ULL;  // Start full
+}
+
+// Whether a message of len bytes can ever leave class c's queue
+bool DownlinkScheduler::Sendable(size_t c, size_t len) const {
+    if (len > mtu_) return false;
+    return config_[c].rateBytesPerSec == 0 || len <= config_[c].burstBytes;
+}
+
+bool DownlinkScheduler::Enqueue(Class c, const uint8_t* data, size_t len, uint64_t now_us) {
+    if (c >= NUM_CLASSES || len == 0) return false;
+    if (!Sendable(c, len)) {
+        stats_[c].dropped++;
+        return false;
+    }
+    ClassQueue& q = queues_[c];
+
+    if (q.count == QUEUE_DEPTH) {
+        stats_[c].dropped++;
+        if (!config_[c].dropOldest) return false;
+        q.head = (q.head + 1) % QUEUE_DEPTH;
+        q.count--;
+    }
+
+    Message& m = q.slots[(q.head + q.count) % QUEUE_DEPTH];
+    m.enqueuedUs = now_us;
+    m.len = static_cast<uint16_t>(len);
+    std::memcpy(m.data, data, len);
+    q.count++;
+    stats_[c].queued++;
+    return true;
+}
+
+void DownlinkScheduler::Refill(uint64_t now_us) {
+    if (lastRefillUs_ == 0 || now_us < lastRefillUs_) {
+        lastRefillUs_ = now_us;
+        return;
+    }
+    const uint64_t dt = now_us - lastRefillUs_;
+    lastRefillUs_ = now_us;
+    for (size_t c = 0; c < NUM_CLASSES; ++c) {
+        if (config_[c].rateBytesPerSec == 0) continue;
+        const uint64_t cap = static_cast<uint64_t>(config_[c].burstBytes) * 1'000'000ULL;
+        tokens_[c] += config_[c].rateBytesPerSec * dt;
+        if (tokens_[c] > cap) tokens_[c] = cap;
+    }
+}
+
+size_t DownlinkScheduler::BuildFrame(uint8_t* out, size_t mtu, uint64_t now_us) {
+    Refill(now_us);
+    size_t used = 0;
+
+    // Strict priority: drain a class as far as its budget and the MTU
+    // allow before looking at the next one
+    for (size_t c = 0; c < NUM_CLASSES; ++c) {
+        ClassQueue& q = queues_[c];
+        const bool limited = config_[c].rateBytesPerSec != 0;
+        while (q.count > 0) {
+            const Message& m = q.slots[q.head];
+            if (!Sendable(c, m.len)) {
+                // Burst lowered since it was queued: drop it, don't block the class
+                stats_[c].dropped++;
+                q.head = (q.head + 1) % QUEUE_DEPTH;
+                q.count--;
+                continue;
+            }
+            const uint64_t cost = static_cast<uint64_t>(m.len) * 1'000'000ULL;
+            if (used + m.len > mtu) break;
+            if (limited && tokens_[c] < cost) break;
+
+            std::memcpy(out + used, m.data, m.len);
+            used += m.len;
+            if (limited) tokens_[c] -= cost;
+
+            ClassStats& st = stats_[c];
+            const uint64_t latency = now_us > m.enqueuedUs ? now_us - m.enqueuedUs : 0;
+            st.sent++;
+            st.bytesSent += m.len;
+            st.totalLatencyUs += latency;
+            if (latency > st.maxLatencyUs) st.maxLatencyUs = static_cast<uint32_t>(latency);
+
+            q.head = (q.head + 1) % QUEUE_DEPTH;
+            q.count--;
+        }
+    }
+
+    if (used > 0) {
+        if (firstFrameUs_ == 0) firstFrameUs_ = now_us;
+        linkBytes_ += used;
+    }
+    return used;
+}
+
+uint32_t DownlinkScheduler::AverageLatencyUs(Class c) const {
+    const ClassStats& st = stats_[c];
+    return st.sent ? static_cast<uint32_t>(st.totalLatencyUs / st.sent) : 0;
+}
+
+float DownlinkScheduler::LinkUtilization(uint64_t now_us) const {
+    if (firstFrameUs_ == 0 || now_us <= firstFrameUs_ || linkBytesPerSec_ == 0) return 0.0f;
+    const double capacity = static_cast<double>(linkBytesPerSec_) * (now_us - firstFrameUs_) / 1e6;
+    return static_cast<float>(linkBytes_ / capacity);
+}
+
+msg::link_stats DownlinkScheduler::Snapshot(uint64_t now_us) const {
+    msg::link_stats s{};
+    float util = LinkUtilization(now_us);
+    if (util > 1.0f) util = 1.0f;
+    s.utilization_pm = static_cast<uint16_t>(util * 1000.0f + 0.5f);
+    for (size_t c = 0; c < NUM_CLASSES; ++c) {
+        s.avg_latency_us[c] = AverageLatencyUs(static_cast<Class>(c));
+        s.max_latency_us[c] = stats_[c].maxLatencyUs;
+        s.dropped[c] = stats_[c].dropped > 0xFFFF ? 0xFFFF : static_cast<uint16_t>(stats_[c].dropped);
+    }
+    s.ms = static_cast<uint32_t>(now_us / 1000);
+    return s;
+}
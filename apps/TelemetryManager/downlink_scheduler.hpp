@@ -0,0 +1,93 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "apps/TelemetryManager/telemetry_encoder.hpp"
+
+// Priority-aware downlink scheduler
+//
+// Encoded telemetry frames are queued per traffic class. Each radio frame
+// is filled in strict class priority (EVENT first, bulk IMU last), subject
+// to a token bucket per class, and packs as many queued messages as fit in
+// the radio MTU so per-transmission overhead (preamble, sync, turnaround)
+// is paid once for several small messages. A class whose budget is used
+// up waits for its bucket to refill even if the link is idle, so bulk data
+// cannot crowd out critical traffic.
+//
+// A message longer than the radio MTU, or than its class's burst, could
+// never be sent and would block its class for good: Enqueue refuses it,
+// and one left behind by a later Configure is dropped when it reaches the
+// head of its queue.
+//
+// Not thread-safe: owned and driven by the TelemetryManager task.
+class DownlinkScheduler {
+    public:
+        enum Class : uint8_t { EVENT, CMD_ACK, STATE, GNSS, IMU, NUM_CLASSES };
+        static_assert(NUM_CLASSES == msg::link_stats::NUM_CLASSES, "link_stats has one entry per class");
+
+        struct ClassConfig {
+            uint32_t rateBytesPerSec; // Token refill rate, 0: unlimited
+            uint32_t burstBytes;      // Bucket size
+            bool dropOldest;          // Queue full: drop oldest (true) or newest (false)
+        };
+
+        struct ClassStats {
+            uint32_t queued;          // Messages accepted
+            uint32_t sent;
+            uint32_t dropped;         // Lost to a full queue, or too long to ever send
+            uint64_t bytesSent;
+            uint64_t totalLatencyUs;  // Enqueue -> packed into a radio frame
+            uint32_t maxLatencyUs;
+        };
+
+        static constexpr size_t QUEUE_DEPTH = 16;
+        static constexpr size_t MAX_MESSAGE_LEN = TelemetryEncoder::HEADER_LEN +
+                                                  TelemetryEncoder::MAX_PAYLOAD_LEN +
+                                                  TelemetryEncoder::CRC_LEN;
+
+        // mtu: largest radio frame BuildFrame is ever given room for
+        explicit DownlinkScheduler(uint32_t linkBytesPerSec, size_t mtu = MAX_MESSAGE_LEN);
+
+        void Configure(Class c, const ClassConfig& config);
+
+        // Copies one encoded message into its class queue; false if it was
+        // dropped (queue full, or longer than the MTU or the class burst)
+        bool Enqueue(Class c, const uint8_t* data, size_t len, uint64_t now_us);
+
+        // Packs queued messages into out (at most mtu bytes), returns bytes used
+        size_t BuildFrame(uint8_t* out, size_t mtu, uint64_t now_us);
+
+        size_t Pending(Class c) const { return queues_[c].count; }
+        const ClassStats& Stats(Class c) const { return stats_[c]; }
+        uint32_t AverageLatencyUs(Class c) const;
+
+        // Share of the link capacity used since the first frame, 0..1
+        float LinkUtilization(uint64_t now_us) const;
+
+        // Snapshot for the LINK_STATS downlink frame
+        msg::link_stats Snapshot(uint64_t now_us) const;
+
+    private:
+        struct Message {
+            uint64_t enqueuedUs;
+            uint16_t len;
+            uint8_t data[MAX_MESSAGE_LEN];
+        };
+
+        struct ClassQueue {
+            Message slots[QUEUE_DEPTH];
+            size_t head = 0, count = 0;
+        };
+
+        void Refill(uint64_t now_us);
+        bool Sendable(size_t c, size_t len) const;
+
+        uint32_t linkBytesPerSec_;
+        size_t mtu_;
+        ClassConfig config_[NUM_CLASSES];
+        ClassQueue queues_[NUM_CLASSES];
+        ClassStats stats_[NUM_CLASSES] = {};
+        uint64_t tokens_[NUM_CLASSES];   // Byte-microseconds, so refill stays integer
+        uint64_t lastRefillUs_ = 0;
+        uint64_t firstFrameUs_ = 0;
+        uint64_t linkBytes_ = 0;
+};
@@ -0,0 +1,196 @@
+#include "apps/TelemetryManager/imu_compressor.hpp"
+
+#include <cmath>
+
+namespace {
+
+// LSB-first bit writer with a 64-bit accumulator
+class BitWriter {
+    public:
+        BitWriter(uint8_t* out, size_t cap) : out_(out), cap_(cap) {}
+
+        void Put(uint32_t value, unsigned bits) {
+            if (bits == 0) return;
+            acc_ |= static_cast<uint64_t>(value & Mask(bits)) << fill_;
+            fill_ += bits;
+            while (fill_ >= 8) {
+                if (pos_ < cap_) out_[pos_] = static_cast<uint8_t>(acc_);
+                pos_++;
+                acc_ >>= 8;
+                fill_ -= 8;
+            }
+        }
+
+        // Pads to a byte, returns total bytes (may exceed cap: caller checks)
+        size_t Finish() {
+            if (fill_ > 0) {
+                if (pos_ < cap_) out_[pos_] = static_cast<uint8_t>(acc_);
+                pos_++;
+                acc_ = 0;
+                fill_ = 0;
+            }
+            return pos_;
+        }
+
+        static uint32_t Mask(unsigned bits) {
+            return bits >= 32 ? 0xFFFFFFFFu : ((1u << bits) - 1);
+        }
+
+    private:
+        uint8_t* out_;
+        size_t cap_;
+        size_t pos_ = 0;
+        uint64_t acc_ = 0;
+        unsigned fill_ = 0;
+};
+
+class BitReader {
+    public:
+        BitReader(const uint8_t* in, size_t len) : in_(in), len_(len) {}
+
+        bool Get(unsigned bits, uint32_t& value) {
+            if (bits == 0) {
+                value = 0;
+                return true;
+            }
+            while (fill_ < bits) {
+                if (pos_ >= len_) return false;
+                acc_ |= static_cast<uint64_t>(in_[pos_++]) << fill_;
+                fill_ += 8;
+            }
+            value = static_cast<uint32_t>(acc_) & BitWriter::Mask(bits);
+            acc_ >>= bits;
+            fill_ -= bits;
+            return true;
+        }
+
+        size_t Consumed() const { return pos_; }  // Whole bytes, padding included
+
+    private:
+        const uint8_t* in_;
+        size_t len_;
+        size_t pos_ = 0;
+        uint64_t acc_ = 0;
+        unsigned fill_ = 0;
+};
+
+inline uint32_t ZigZag(int32_t v) {
+    return (static_cast<uint32_t>(v) << 1) ^ static_cast<uint32_t>(v >> 31);
+}
+
+inline int32_t UnZigZag(uint32_t v) {
+    return static_cast<int32_t>((v >> 1) ^ (~(v & 1) + 1));
+}
+
+inline unsigned BitWidth(uint32_t v) {
+    return v == 0 ? 0 : 32 - __builtin_clz(v);
+}
+
+// Values with a 6-bit width prefix, for keyframes and delta bases
+inline void PutVarWidth(BitWriter& w, uint32_t v) {
+    unsigned width = BitWidth(v);
+    w.Put(width, 6);
+    w.Put(v, width);
+}
+
+inline bool GetVarWidth(BitReader& r, uint32_t& v) {
+    uint32_t width;
+    return r.Get(6, width) && width <= 32 && r.Get(width, v);
+}
+
+// Saturates out-of-range values; NaN (a failed sensor read) becomes 0,
+// since converting it to an integer is undefined
+inline int32_t Quantize(float v, float scale) {
+    float q = std::nearbyint(v * scale);
+    if (std::isnan(q)) return 0;
+    if (q >= 2147483520.0f) return INT32_MAX;
+    if (q <= -2147483520.0f) return INT32_MIN;
+    return static_cast<int32_t>(q);
+}
+
+} // namespace
+
+ImuCompressor::ImuCompressor(const ImuCompressionConfig& config)
+    : accelScale_(1.0f / config.accelLsb), gyroScale_(1.0f / config.gyroLsb), config_(config) {}
+
+size_t ImuCompressor::EncodeBlock(const msg::imu* samples, size_t n, uint8_t* out, size_t cap) const {
+    if (n == 0 || n > MAX_BLOCK_SAMPLES || cap == 0) return 0;
+
+    // Quantize into channel-major order so each channel is one tight loop
+    int32_t q[CHANNELS][MAX_BLOCK_SAMPLES];
+    for (size_t i = 0; i < n; ++i) {
+        const msg::imu& s = samples[i];
+        q[0][i] = Quantize(s.ax, accelScale_);
+        q[1][i] = Quantize(s.ay, accelScale_);
+        q[2][i] = Quantize(s.az, accelScale_);
+        q[3][i] = Quantize(s.gx, gyroScale_);
+        q[4][i] = Quantize(s.gy, gyroScale_);
+        q[5][i] = Quantize(s.gz, gyroScale_);
+        q[6][i] = static_cast<int32_t>(s.ms);
+    }
+
+    BitWriter w(out, cap);
+    w.Put(static_cast<uint32_t>(n), 8);
+
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        // Wrapping differences, so extreme values still round-trip
+        int32_t delta[MAX_BLOCK_SAMPLES];
+        int32_t base = 0;
+        for (size_t i = 1; i < n; ++i) {
+            delta[i] = static_cast<int32_t>(static_cast<uint32_t>(q[c][i]) -
+                                            static_cast<uint32_t>(q[c][i - 1]));
+            if (i == 1 || delta[i] < base) base = delta[i];
+        }
+        // Residuals against the smallest delta are non-negative, and a
+        // constant rate (e.g. the timestamp) packs into zero bits
+        uint32_t all = 0;
+        uint32_t residual[MAX_BLOCK_SAMPLES];
+        for (size_t i = 1; i < n; ++i) {
+            residual[i] = static_cast<uint32_t>(delta[i]) - static_cast<uint32_t>(base);
+            all |= residual[i];
+        }
+        const unsigned width = BitWidth(all);
+
+        PutVarWidth(w, ZigZag(q[c][0]));
+        PutVarWidth(w, ZigZag(base));
+        w.Put(width, 6);
+        for (size_t i = 1; i < n; ++i) {
+            w.Put(residual[i], width);
+        }
+    }
+
+    size_t bytes = w.Finish();
+    return bytes <= cap ? bytes : 0;
+}
+
+size_t ImuCompressor::DecodeBlock(const uint8_t* in, size_t len, msg::imu* out, size_t* consumed) const {
+    BitReader r(in, len);
+    uint32_t n;
+    if (!r.Get(8, n) || n == 0 || n > MAX_BLOCK_SAMPLES) return 0;
+
+    int32_t q[CHANNELS][MAX_BLOCK_SAMPLES];
+    for (size_t c = 0; c < CHANNELS; ++c) {
+        uint32_t key, base, width;
+        if (!GetVarWidth(r, key) || !GetVarWidth(r, base) || !r.Get(6, width) || width > 32) return 0;
+        q[c][0] = UnZigZag(key);
+        const uint32_t baseDelta = static_cast<uint32_t>(UnZigZag(base));
+        for (size_t i = 1; i < n; ++i) {
+            uint32_t residual;
+            if (!r.Get(width, residual)) return 0;
+            q[c][i] = static_cast<int32_t>(static_cast<uint32_t>(q[c][i - 1]) + baseDelta + residual);
+        }
+    }
+
+    for (size_t i = 0; i < n; ++i) {
+        msg::imu& s = out[i];
+        s.ax = q[0][i] * config_.accelLsb;
+        s.ay = q[1][i] * config_.accelLsb;
+        s.az = q[2][i] * config_.accelLsb;
+        s.gx = q[3][i] * config_.gyroLsb;
+        s.gy = q[4][i] * config_.gyroLsb;
+        s.gz = q[5][i] * config_.gyroLsb;
+        s.ms = static_cast<uint32_t>(q[6][i]);
+    }
+    if (consumed) *consumed = r.Consumed();
+    return n;
+}
@@ -0,0 +1,52 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "msg/messages.hpp"
+
+// Lossy-quantized, lossless-packed compression of msg::imu blocks
+//
+// Each channel (ax..gz, plus the ms timestamp) is quantized to a fixed-
+// point integer with a configurable resolution. A block of samples then
+// stores, per channel, the first sample as keyframe and the sample-to-
+// sample deltas. Deltas are taken relative to the block's smallest delta
+// (so they are non-negative and a constant rate costs zero bits) and
+// bit-packed at the smallest width that fits all of them:
+//
+//   | count (u8) | per channel: key, base, width (6 bits), count-1 residuals |
+//
+// key and base are zigzag values with a 6-bit width prefix. All fields are
+// bit-packed LSB first; the block is padded to a byte. Deltas of IMU data
+// at the default resolutions need about 6 bits, so a 28-byte sample
+// shrinks to roughly 5-6 bytes. The ground side decodes with the same
+// ImuCompressionConfig. Values beyond the quantizer range (including
+// +-Inf) saturate, NaN is sent as 0.
+struct ImuCompressionConfig {
+    float accelLsb = 0.004f;   // m/s^2 per count (~0.4 mg, below typical MEMS noise)
+    float gyroLsb = 0.0005f;   // rad/s per count (~0.03 deg/s)
+};
+
+class ImuCompressor {
+    public:
+        static constexpr size_t MAX_BLOCK_SAMPLES = 32;
+        static constexpr size_t CHANNELS = 7;  // ax, ay, az, gx, gy, gz, ms
+
+        explicit ImuCompressor(const ImuCompressionConfig& config = ImuCompressionConfig{});
+
+        // Encodes samples[0..n) (n <= MAX_BLOCK_SAMPLES) into out.
+        // Returns the block size in bytes, or 0 if it does not fit in cap.
+        size_t EncodeBlock(const msg::imu* samples, size_t n, uint8_t* out, size_t cap) const;
+
+        // Decodes one block into out (room for MAX_BLOCK_SAMPLES).
+        // Returns the number of samples, 0 if the block is malformed.
+        size_t DecodeBlock(const uint8_t* in, size_t len, msg::imu* out,
+                           size_t* consumed = nullptr) const;
+
+        // Upper bound on EncodeBlock output for n samples
+        static constexpr size_t MaxBlockBytes(size_t n) {
+            return 1 + (CHANNELS * (3 * 6 + 2 * 32 + (n > 0 ? n - 1 : 0) * 32) + 7) / 8;
+        }
+
+    private:
+        float accelScale_, gyroScale_;  // counts per unit (1 / lsb)
+        ImuCompressionConfig config_;
+};
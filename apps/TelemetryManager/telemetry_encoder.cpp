@@ -0,0 +1,117 @@
+#include "apps/TelemetryManager/telemetry_encoder.hpp"
+#include "utils/crc16.hpp"
+
+#include <cstring>
+
+// Little-endian stores, independent of host byte order
+static inline uint8_t* PutU16(uint8_t* p, uint16_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    return p + 2;
+}
+
+static inline uint8_t* PutU32(uint8_t* p, uint32_t v) {
+    p[0] = static_cast<uint8_t>(v);
+    p[1] = static_cast<uint8_t>(v >> 8);
+    p[2] = static_cast<uint8_t>(v >> 16);
+    p[3] = static_cast<uint8_t>(v >> 24);
+    return p + 4;
+}
+
+static inline uint8_t* PutF32(uint8_t* p, float f) {
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return PutU32(p, bits);
+}
+
+TelemetryEncoder::TelemetryEncoder(uint8_t* buffer, size_t capacity)
+    : buffer_(buffer), capacity_(capacity) {}
+
+uint8_t* TelemetryEncoder::Begin(Type type, size_t payloadLen, uint32_t ms) {
+    if (Free() < HEADER_LEN + payloadLen + CRC_LEN) return nullptr;
+    uint8_t* p = buffer_ + size_;
+    p[0] = SYNC_0;
+    p[1] = SYNC_1;
+    p[2] = type;
+    p[3] = static_cast<uint8_t>(payloadLen);
+    PutU16(p + 4, seq_);
+    PutU32(p + 6, ms);
+    return p;
+}
+
+size_t TelemetryEncoder::Finish(uint8_t* frame, size_t payloadLen) {
+    const size_t bodyLen = HEADER_LEN - 2 + payloadLen;
+    PutU16(frame + 2 + bodyLen, Crc16::Compute(frame + 2, bodyLen));
+    const size_t frameLen = HEADER_LEN + payloadLen + CRC_LEN;
+    size_ += frameLen;
+    seq_++;
+    return frameLen;
+}
+
+size_t TelemetryEncoder::Encode(const msg::imu& m) {
+    uint8_t* frame = Begin(IMU, IMU_PAYLOAD_LEN, m.ms);
+    if (!frame) return 0;
+    uint8_t* p = frame + HEADER_LEN;
+    p = PutF32(p, m.ax);
+    p = PutF32(p, m.ay);
+    p = PutF32(p, m.az);
+    p = PutF32(p, m.gx);
+    p = PutF32(p, m.gy);
+    PutF32(p, m.gz);
+    return Finish(frame, IMU_PAYLOAD_LEN);
+}
+
+size_t TelemetryEncoder::Encode(const msg::est& m) {
+    uint8_t* frame = Begin(EST, EST_PAYLOAD_LEN, m.ms);
+    if (!frame) return 0;
+    uint8_t* p = frame + HEADER_LEN;
+    p = PutF32(p, m.roll);
+    p = PutF32(p, m.pitch);
+    p = PutF32(p, m.yaw);
+    p = PutF32(p, m.climb);
+    PutF32(p, m.baro_alt);
+    return Finish(frame, EST_PAYLOAD_LEN);
+}
+
+size_t TelemetryEncoder::Encode(const msg::cmd_ack& m) {
+    uint8_t* frame = Begin(CMD_ACK, CMD_ACK_PAYLOAD_LEN, m.ms);
+    if (!frame) return 0;
+    uint8_t* p = frame + HEADER_LEN;
+    *p++ = static_cast<uint8_t>(m.result);
+    *p++ = static_cast<uint8_t>(m.type);
+    PutU32(p, static_cast<uint32_t>(m.arg));
+    return Finish(frame, CMD_ACK_PAYLOAD_LEN);
+}
+
+size_t TelemetryEncoder::Encode(const msg::link_stats& m) {
+    uint8_t* frame = Begin(LINK_STATS, LINK_STATS_PAYLOAD_LEN, m.ms);
+    if (!frame) return 0;
+    uint8_t* p = frame + HEADER_LEN;
+    p = PutU16(p, m.utilization_pm);
+    for (int c = 0; c < msg::link_stats::NUM_CLASSES; ++c) p = PutU32(p, m.avg_latency_us[c]);
+    for (int c = 0; c < msg::link_stats::NUM_CLASSES; ++c) p = PutU32(p, m.max_latency_us[c]);
+    for (int c = 0; c < msg::link_stats::NUM_CLASSES; ++c) p = PutU16(p, m.dropped[c]);
+    return Finish(frame, LINK_STATS_PAYLOAD_LEN);
+}
+
+size_t TelemetryEncoder::Encode(const msg::flight_event& m) {
+    uint8_t* frame = Begin(FLIGHT_EVENT, FLIGHT_EVENT_PAYLOAD_LEN, m.ms);
+    if (!frame) return 0;
+    uint8_t* p = frame + HEADER_LEN;
+    *p++ = static_cast<uint8_t>(m.type);
+    PutF32(p, m.alt);
+    return Finish(frame, FLIGHT_EVENT_PAYLOAD_LEN);
+}
+
+size_t TelemetryEncoder::Encode(const msg::imu* samples, size_t n, const ImuCompressor& compressor) {
+    if (n == 0 || Free() < HEADER_LEN + CRC_LEN + 1) return 0;
+    size_t room = Free() - HEADER_LEN - CRC_LEN;
+    if (room > MAX_PAYLOAD_LEN) room = MAX_PAYLOAD_LEN;
+
+    // The block is compressed in place, then the header is filled around it
+    uint8_t* frame = buffer_ + size_;
+    size_t payloadLen = compressor.EncodeBlock(samples, n, frame + HEADER_LEN, room);
+    if (payloadLen == 0) return 0;
+    Begin(IMU_BLOCK, payloadLen, samples[0].ms);
+    return Finish(frame, payloadLen);
+}
@@ -0,0 +1,68 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "msg/messages.hpp"
+#include "apps/TelemetryManager/imu_compressor.hpp"
+
+// Fixed-layout binary downlink frames
+//
+// Every frame is little-endian, including the CRC:
+//
+//   | 0x1A 0xCF | type | len | seq (u16) | ms (u32) | payload (len) | crc16 |
+//     sync        1 B    1 B    2 B         4 B                       2 B
+//
+// seq counts frames across all types so the ground can spot gaps. The CRC
+// is CRC-16/CCITT-FALSE over type..payload. Payloads are the message
+// fields in declaration order, floats as IEEE-754 bit patterns.
+//
+// The encoder appends frames directly into a caller-owned downlink buffer:
+// no heap, no string formatting, one pass over the payload.
+class TelemetryEncoder {
+    public:
+        static constexpr uint8_t SYNC_0 = 0x1A;
+        static constexpr uint8_t SYNC_1 = 0xCF;
+        static constexpr size_t HEADER_LEN = 2 + 1 + 1 + 2 + 4;
+        static constexpr size_t CRC_LEN = 2;
+
+        enum Type : uint8_t { IMU = 1, EST = 2, CMD_ACK = 3, IMU_BLOCK = 4, LINK_STATS = 5, FLIGHT_EVENT = 6 };
+
+        static constexpr size_t IMU_PAYLOAD_LEN = 6 * 4;
+        static constexpr size_t EST_PAYLOAD_LEN = 5 * 4;
+        static constexpr size_t CMD_ACK_PAYLOAD_LEN = 1 + 1 + 4;
+        static constexpr size_t LINK_STATS_PAYLOAD_LEN = 2 + msg::link_stats::NUM_CLASSES * (4 + 4 + 2);
+        static constexpr size_t FLIGHT_EVENT_PAYLOAD_LEN = 1 + 4;
+        static constexpr size_t MAX_PAYLOAD_LEN = 255;  // len is one byte
+
+        // Largest fixed-layout frame the encoder produces
+        static constexpr size_t MAX_FRAME_LEN = HEADER_LEN + LINK_STATS_PAYLOAD_LEN + CRC_LEN;
+
+        TelemetryEncoder(uint8_t* buffer, size_t capacity);
+
+        // Each returns the frame length appended, or 0 if it did not fit
+        size_t Encode(const msg::imu& m);
+        size_t Encode(const msg::est& m);
+        size_t Encode(const msg::cmd_ack& m);
+        size_t Encode(const msg::link_stats& m);
+        size_t Encode(const msg::flight_event& m);
+
+        // Compresses samples[0..n) straight into an IMU_BLOCK frame; ms is
+        // taken from the first sample. Returns 0 if the compressed block
+        // does not fit (send fewer samples, or plain IMU frames).
+        size_t Encode(const msg::imu* samples, size_t n, const ImuCompressor& compressor);
+
+        const uint8_t* Data() const { return buffer_; }
+        size_t Size() const { return size_; }
+        size_t Free() const { return capacity_ - size_; }
+        void Clear() { size_ = 0; }   // After the buffer has been handed to the radio
+
+        uint16_t NextSeq() const { return seq_; }
+
+    private:
+        uint8_t* Begin(Type type, size_t payloadLen, uint32_t ms);
+        size_t Finish(uint8_t* frame, size_t payloadLen);
+
+        uint8_t* buffer_;
+        size_t capacity_;
+        size_t size_ = 0;
+        uint16_t seq_ = 0;
+};
@@ -0,0 +1,140 @@
+#include "apps/TelemetryManager/telemetry_manager.hpp"
+#include "apps/TelemetryManager/telemetry_encoder.hpp"
+#include "apps/TelemetryManager/downlink_scheduler.hpp"
+#include "apps/TimerService/timer_service.hpp"
+#include "queues/queues.hpp"
+#include "os/rtos.hpp"
+
+static TelemetryManager::DownlinkWriter g_downlink = nullptr;
+
+// Pre-allocated buffers: one radio block, and one message while it is
+// encoded. A message never exceeds the block, so the scheduler can send it.
+static uint8_t g_downlink_buffer[TelemetryManager::DOWNLINK_BUFFER_SIZE];
+static uint8_t g_message_buffer[TelemetryManager::DOWNLINK_BUFFER_SIZE];
+static_assert(TelemetryEncoder::MAX_FRAME_LEN <= TelemetryManager::DOWNLINK_BUFFER_SIZE,
+              "every fixed-layout frame must fit one radio block");
+
+static DownlinkScheduler g_scheduler(TelemetryManager::LINK_BYTES_PER_SEC, TelemetryManager::DOWNLINK_BUFFER_SIZE);
+
+// IMU samples waiting to be compressed into one IMU_BLOCK frame
+static const ImuCompressor g_compressor;
+static msg::imu g_imu_batch[ImuCompressor::MAX_BLOCK_SAMPLES];
+
+void TelemetryManager::SetDownlink(DownlinkWriter writer) {
+    g_downlink = writer;
+}
+
+// Encodes one message and queues it under its traffic class. seq is taken
+// at encode time, so a gap on the ground means the scheduler dropped it.
+template <typename Msg>
+static void Post(TelemetryEncoder& enc, DownlinkScheduler::Class c, const Msg& m, uint64_t now) {
+    enc.Clear();
+    size_t len = enc.Encode(m);
+    if (len) g_scheduler.Enqueue(c, enc.Data(), len, now);
+}
+
+// Compresses samples[0..n) into IMU_BLOCK frames. A block that does not
+// fit one frame (unusually large deltas) is sent as two halves.
+static void PostImu(TelemetryEncoder& enc, const msg::imu* samples, size_t n, uint64_t now) {
+    enc.Clear();
+    size_t len = enc.Encode(samples, n, g_compressor);
+    if (len) {
+        g_scheduler.Enqueue(DownlinkScheduler::IMU, enc.Data(), len, now);
+    } else if (n > 1) {
+        PostImu(enc, samples, n / 2, now);
+        PostImu(enc, samples + n / 2, n - n / 2, now);
+    }
+}
+
+// Per-class budgets, in bytes/s out of LINK_BYTES_PER_SEC. Events and acks
+// are unlimited; bulk IMU data gets what is left and sheds its oldest samples.
+static void ConfigureClasses() {
+    g_scheduler.Configure(DownlinkScheduler::STATE, {1000, 256, true});
+    g_scheduler.Configure(DownlinkScheduler::GNSS,  { 600, 128, true});
+    g_scheduler.Configure(DownlinkScheduler::IMU,   {2400, 512, true});
+}
+
+void TelemetryManager::Run(void*) {
+    TelemetryEncoder enc(g_message_buffer, sizeof(g_message_buffer));
+    ConfigureClasses();
+
+    const uint32_t bytesPerCycle = static_cast<uint32_t>(
+        static_cast<uint64_t>(LINK_BYTES_PER_SEC) * PERIOD_US / 1000000);
+    uint32_t credit = 0;  // Link bytes not yet spent
+    uint64_t nextStats = Rtos::NowUs() + LINK_STATS_PERIOD_US;
+    uint32_t estVersion = 0;   // Last estimator snapshot sent
+    uint32_t imuSeen = 0;      // IMU samples received, for decimation
+    size_t imuBatched = 0;
+
+    // Acks and flight events wake the task as soon as they are published;
+    // everything else runs on the downlink cycle timer
+    Bus::Subscription<Topics::CMD_ACK> acks;
+    Bus::Subscription<Topics::FLIGHT_EVENT> events;
+    Rtos::QueueSet inputs;
+    inputs.add(acks);
+    inputs.add(events);
+    const uint32_t CYCLE = inputs.add_signal();
+    Timer cycle(inputs, CYCLE);
+    TimerService::Start(cycle, PERIOD_US / 1000, PERIOD_US / 1000);
+
+    // IMU data is bulk: drained on its own timer, well before the topic
+    // ring overruns, rather than waking the task for every sample
+    Bus::Subscription<Topics::IMU> imu;
+    const uint32_t IMU_DRAIN = inputs.add_signal();
+    Timer imuDrain(inputs, IMU_DRAIN);
+    TimerService::Start(imuDrain, IMU_DRAIN_MS, IMU_DRAIN_MS);
+
+    while(true) {
+        const uint32_t ready = inputs.wait();
+        uint64_t now = Rtos::NowUs();
+
+        msg::cmd_ack ack;
+        while (acks.try_receive(ack)) {
+            Post(enc, DownlinkScheduler::CMD_ACK, ack, now);
+        }
+        msg::flight_event event;
+        while (events.try_receive(event)) {
+            Post(enc, DownlinkScheduler::EVENT, event, now);
+        }
+
+        if (ready & IMU_DRAIN) {
+            msg::imu sample;
+            while (imu.try_receive(sample)) {
+                if (imuSeen++ % IMU_DOWNLINK_DECIMATION) continue;
+                g_imu_batch[imuBatched++] = sample;
+                if (imuBatched == ImuCompressor::MAX_BLOCK_SAMPLES) {
+                    PostImu(enc, g_imu_batch, imuBatched, now);
+                    imuBatched = 0;
+                }
+            }
+        }
+
+        if (ready & CYCLE) {
+            // Only the newest state is worth the link; older ones are never queued
+            msg::est est;
+            const uint32_t version = Topics::EstState.read(est);
+            if (version != estVersion) {
+                Post(enc, DownlinkScheduler::STATE, est, now);
+                estVersion = version;
+            }
+            if (now >= nextStats) {
+                Post(enc, DownlinkScheduler::STATE, g_scheduler.Snapshot(now), now);
+                nextStats += LINK_STATS_PERIOD_US;
+            }
+
+            // Unused credit carries over, up to one extra block
+            credit += bytesPerCycle;
+            if (credit > DOWNLINK_BUFFER_SIZE + bytesPerCycle) credit = DOWNLINK_BUFFER_SIZE + bytesPerCycle;
+        }
+
+        // Send as many radio blocks as the credit allows. Mid-cycle this is
+        // what is left over, so an ack goes out at once when the link has room.
+        while (credit > 0) {
+            size_t mtu = credit < DOWNLINK_BUFFER_SIZE ? credit : DOWNLINK_BUFFER_SIZE;
+            size_t len = g_scheduler.BuildFrame(g_downlink_buffer, mtu, now);
+            if (len == 0) break;
+            if (g_downlink) g_downlink(g_downlink_buffer, len);
+            credit -= static_cast<uint32_t>(len);
+        }
+    }
+}
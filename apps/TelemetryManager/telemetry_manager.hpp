@@ -1,6 +1,21 @@
 #pragma once
+#include <cstddef>
+#include <cstdint>
 
 class TelemetryManager {
     public:
+        // Hands a block of encoded frames to the radio, false if it was dropped
+        using DownlinkWriter = bool (*)(const uint8_t* data, size_t len);
+
+        static constexpr uint32_t PERIOD_US = 100000;      // 10 Hz downlink cycle
+        static constexpr size_t DOWNLINK_BUFFER_SIZE = 256; // One radio block (MTU)
+        static constexpr uint32_t LINK_BYTES_PER_SEC = 4800; // Usable radio throughput
+        static constexpr uint32_t LINK_STATS_PERIOD_US = 1000000;
+        static constexpr uint32_t IMU_DRAIN_MS = 8;             // The IMU topic holds 16 ms at 1 kHz
+        static constexpr uint32_t IMU_DOWNLINK_DECIMATION = 4;  // 1 kHz -> 250 Hz, within the IMU class budget
+
+        // Call before the task is started; without a writer frames are discarded
+        static void SetDownlink(DownlinkWriter writer);
+
         static void Run(void* args); //Rtos task entry point
-};
\ No newline at end of file
+};
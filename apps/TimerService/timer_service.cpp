@@ -0,0 +1,125 @@
+#include "apps/TimerService/timer_service.hpp"
+
+#include <cstddef>
+
+static uint64_t NowTick() { return Rtos::NowUs() / TimerService::TICK_US; }
+static uint64_t MsToTicks(uint32_t ms) { return static_cast<uint64_t>(ms) * 1000 / TimerService::TICK_US; }
+
+static Rtos::Mutex g_lock;                         // Guards everything below and Timer state
+static TimingWheel g_wheel(NowTick());
+static TimingWheel::Node* g_due = nullptr;         // Expired, action not yet run, oldest first
+static TimingWheel::Node** g_dueTail = &g_due;
+static uint64_t g_nextWake = TimingWheel::NEVER;   // Tick the task is sleeping until
+
+static Rtos::EventGroup g_wake;                    // Start() of an earlier timer wakes the task
+static constexpr uint32_t WAKE_BIT = 0x1;
+
+Timer::~Timer() {
+    TimerService::Stop(*this);
+}
+
+// Takes n off the due list, keeping g_dueTail valid
+static void UnlinkDue(TimingWheel::Node& n) {
+    if (g_dueTail == &n.next) g_dueTail = n.pprev;
+    TimingWheel::Unlink(n);
+}
+
+Timer* TimerService::FromNode(TimingWheel::Node* n) {
+    return reinterpret_cast<Timer*>(reinterpret_cast<char*>(n) - offsetof(Timer, node_));
+}
+
+void TimerService::Disarm(Timer& t) {
+    if (t.state_ == Timer::ARMED) g_wheel.Remove(t.node_);
+    else if (t.state_ == Timer::DUE) UnlinkDue(t.node_);
+    t.state_ = Timer::IDLE;
+}
+
+void TimerService::Start(Timer& t, uint32_t delay_ms, uint32_t period_ms) {
+    // Rounded up to the next tick boundary so a timer never fires early
+    const uint64_t expires = (Rtos::NowUs() + TICK_US - 1) / TICK_US + MsToTicks(delay_ms);
+
+    g_lock.lock();
+    Disarm(t);
+    t.period_ = static_cast<uint32_t>(MsToTicks(period_ms));
+    t.state_ = Timer::ARMED;
+    g_wheel.Insert(t.node_, expires);
+    const bool sooner = t.node_.expires < g_nextWake;
+    g_lock.unlock();
+
+    if (sooner) g_wake.set(WAKE_BIT);
+}
+
+bool TimerService::Stop(Timer& t) {
+    g_lock.lock();
+    const bool pending = t.state_ != Timer::IDLE;
+    Disarm(t);
+    g_lock.unlock();
+    return pending;
+}
+
+bool TimerService::IsActive(const Timer& t) {
+    g_lock.lock();
+    const bool active = t.state_ != Timer::IDLE;
+    g_lock.unlock();
+    return active;
+}
+
+// Runs the action of one expired timer outside the lock, so it may Start
+// or Stop timers itself. Returns false once nothing is due.
+bool TimerService::FireNext() {
+    g_lock.lock();
+    TimingWheel::Node* n = g_due;
+    if (!n) {
+        g_lock.unlock();
+        return false;
+    }
+    UnlinkDue(*n);
+    Timer* t = FromNode(n);
+    if (t->period_) {
+        // Keep the original phase; periods missed while late are skipped
+        uint64_t next = n->expires + t->period_;
+        const uint64_t now = g_wheel.Now();
+        if (next <= now) next += ((now - next) / t->period_ + 1) * t->period_;
+        g_wheel.Insert(*n, next);
+        t->state_ = Timer::ARMED;
+    } else {
+        t->state_ = Timer::IDLE;
+    }
+    // Copied under the lock: a one-shot timer may be reused as soon as it is IDLE
+    const Timer::Callback fn = t->fn_;
+    void* arg = t->arg_;
+    Rtos::QueueSet* set = t->set_;
+    const uint32_t bits = t->bits_;
+    g_lock.unlock();
+
+    if (fn) fn(arg);
+    else if (set) set->signal(bits);
+    return true;
+}
+
+void TimerService::Run(void*) {
+    while(true) {
+        g_lock.lock();
+        g_wheel.Advance(NowTick(), [](TimingWheel::Node& n) {
+            TimingWheel::Append(g_dueTail, n);   // Fire in expiry-tick order
+            FromNode(&n)->state_ = Timer::DUE;
+        });
+        g_lock.unlock();
+
+        while (FireNext()) {}
+
+        g_lock.lock();
+        const uint64_t next = g_wheel.NextEvent();
+        g_nextWake = next;
+        g_lock.unlock();
+
+        // Sleep until the next tick with work; Start() of an earlier timer cuts it short
+        int timeout_ms = Rtos::MAX_TIMEOUT;
+        if (next != TimingWheel::NEVER) {
+            const uint64_t now = Rtos::NowUs();
+            const uint64_t at = next * TICK_US;
+            timeout_ms = at > now ? static_cast<int>((at - now + 999) / 1000) : 0;
+        }
+        if (timeout_ms != 0) g_wake.wait(WAKE_BIT, false, true, timeout_ms);
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include "utils/timing_wheel.hpp"
+#include "os/rtos.hpp"
+
+// Software timers
+//
+// One task serves every timer in the system from a hierarchical timing
+// wheel (utils/timing_wheel.hpp) with 1 ms ticks: Start and Stop are O(1)
+// under a short lock, and the task sleeps until the next tick with work,
+// so idle timers cost nothing and hundreds of them share one thread.
+//
+// On expiry a timer either calls its callback on the timer task, or sets
+// bits in a QueueSet so the owning task wakes from its usual set wait.
+// Callbacks must be short and must not block (post to a queue with
+// try_send, publish on a topic, or Start/Stop timers). Start and Stop may
+// be called from any task, including from a callback.
+class Timer {
+    public:
+        using Callback = void (*)(void* arg);
+
+        Timer(Callback fn, void* arg) : fn_(fn), arg_(arg) {}
+        Timer(Rtos::QueueSet& set, uint32_t bits) : set_(&set), bits_(bits) {}
+        ~Timer();   // Stops it; a callback already running is not waited for
+
+        Timer(const Timer&) = delete;
+        Timer& operator=(const Timer&) = delete;
+
+    private:
+        friend class TimerService;
+        enum State : uint8_t { IDLE, ARMED, DUE };
+
+        TimingWheel::Node node_;
+        Callback fn_ = nullptr;
+        void* arg_ = nullptr;
+        Rtos::QueueSet* set_ = nullptr;
+        uint32_t bits_ = 0;
+        uint32_t period_ = 0;   // Ticks, 0 for one-shot
+        State state_ = IDLE;
+};
+
+class TimerService {
+    public:
+        static constexpr uint32_t TICK_US = 1000;
+
+        // (Re)arms t to fire after delay_ms (never earlier, usually within a
+        // tick later), then every period_ms if non-zero.
+        // Periodic timers keep their phase: a late expiry does not shift later ones.
+        static void Start(Timer& t, uint32_t delay_ms, uint32_t period_ms = 0);
+
+        // true if t was pending. A callback already running is not waited for.
+        static bool Stop(Timer& t);
+
+        static bool IsActive(const Timer& t);
+
+        static void Run(void* args); //Rtos task entry point
+
+    private:
+        static Timer* FromNode(TimingWheel::Node* n);
+        static void Disarm(Timer& t);   // Caller holds the lock
+        static bool FireNext();
+};
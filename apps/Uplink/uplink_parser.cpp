@@ -0,0 +1,138 @@
+#include "apps/Uplink/uplink_parser.hpp"
+#include "queues/queues.hpp"
+#include "os/rtos.hpp"
+#include "utils/crc16.hpp"
+
+#include <cstring>
+
+static bool PublishCmd(const msg::cmd& c, void*) {
+    return Bus::Publish<Topics::CMD>(c);
+}
+
+UplinkParser::UplinkParser() : UplinkParser(PublishCmd, nullptr) {}
+
+UplinkParser::UplinkParser(Sink sink, void* ctx) : sink_(sink), ctx_(ctx) {}
+
+void UplinkParser::Reset() {
+    state_ = State::SYNC_0;
+    frameLen_ = 0;
+}
+
+size_t UplinkParser::Feed(const uint8_t* data, size_t len) {
+    size_t decoded = 0;
+    for (size_t i = 0; i < len; ++i) {
+        decoded += Step(data[i]);
+    }
+    return decoded;
+}
+
+size_t UplinkParser::Step(uint8_t byte) {
+    switch (state_) {
+        case State::SYNC_0:
+            if (byte == SYNC_0) {
+                frame_[0] = byte;
+                frameLen_ = 1;
+                state_ = State::SYNC_1;
+            } else {
+                stats_.skippedBytes++;
+            }
+            return 0;
+
+        case State::SYNC_1:
+            if (byte == SYNC_1) {
+                frame_[frameLen_++] = byte;
+                state_ = State::LEN;
+                return 0;
+            }
+            stats_.skippedBytes++;  // The lone SYNC_0
+            Reset();
+            return Step(byte);      // May itself be a SYNC_0
+
+        case State::LEN:
+            frame_[frameLen_++] = byte;
+            if (byte != CMD_PAYLOAD_LEN) {
+                stats_.lengthErrors++;
+                return Resync();
+            }
+            payloadLen_ = byte;
+            crc_ = Crc16::Update(Crc16::INIT, byte);
+            state_ = State::PAYLOAD;
+            return 0;
+
+        case State::PAYLOAD:
+            frame_[frameLen_++] = byte;
+            crc_ = Crc16::Update(crc_, byte);
+            if (frameLen_ == 3u + payloadLen_) state_ = State::CRC_HI;
+            return 0;
+
+        case State::CRC_HI:
+            frame_[frameLen_++] = byte;
+            crcHi_ = byte;
+            state_ = State::CRC_LO;
+            return 0;
+
+        case State::CRC_LO:
+            frame_[frameLen_++] = byte;
+            return Complete(static_cast<uint16_t>((crcHi_ << 8) | byte));
+    }
+    return 0;
+}
+
+size_t UplinkParser::Complete(uint16_t rxCrc) {
+    if (rxCrc != crc_) {
+        stats_.crcErrors++;
+        return Resync();
+    }
+
+    const uint8_t* p = &frame_[3];
+    if (p[0] >= msg::cmd::NUM_TYPES) {
+        stats_.lengthErrors++;
+        return Resync();
+    }
+
+    msg::cmd c{};
+    c.type = static_cast<msg::cmd::Type>(p[0]);
+    c.arg = static_cast<int32_t>(static_cast<uint32_t>(p[1]) |
+                                 static_cast<uint32_t>(p[2]) << 8 |
+                                 static_cast<uint32_t>(p[3]) << 16 |
+                                 static_cast<uint32_t>(p[4]) << 24);
+    c.ms = static_cast<uint32_t>(Rtos::NowUs() / 1000);
+    Reset();
+
+    stats_.frames++;
+    if (!sink_(c, ctx_)) stats_.sinkDrops++;
+    return 1;
+}
+
+size_t UplinkParser::Resync() {
+    // Only the rejected candidate is rescanned, starting after its SYNC_0.
+    // Each nested resync works on a strictly shorter tail, so the work per
+    // input byte stays bounded by MAX_FRAME_LEN.
+    uint8_t tail[MAX_FRAME_LEN];
+    size_t tailLen = frameLen_ - 1;
+    std::memcpy(tail, frame_ + 1, tailLen);
+    stats_.skippedBytes++;
+    Reset();
+
+    size_t decoded = 0;
+    for (size_t i = 0; i < tailLen; ++i) {
+        decoded += Step(tail[i]);
+    }
+    return decoded;
+}
+
+size_t UplinkParser::Encode(const msg::cmd& c, uint8_t* out) {
+    const uint32_t arg = static_cast<uint32_t>(c.arg);
+    out[0] = SYNC_0;
+    out[1] = SYNC_1;
+    out[2] = CMD_PAYLOAD_LEN;
+    out[3] = static_cast<uint8_t>(c.type);
+    out[4] = static_cast<uint8_t>(arg);
+    out[5] = static_cast<uint8_t>(arg >> 8);
+    out[6] = static_cast<uint8_t>(arg >> 16);
+    out[7] = static_cast<uint8_t>(arg >> 24);
+    uint16_t crc = Crc16::Compute(out + 2, 1 + CMD_PAYLOAD_LEN);
+    out[8] = static_cast<uint8_t>(crc >> 8);
+    out[9] = static_cast<uint8_t>(crc);
+    return CMD_FRAME_LEN;
+}
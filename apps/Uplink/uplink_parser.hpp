@@ -0,0 +1,71 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include "msg/messages.hpp"
+
+// Streaming uplink frame decoder
+//
+// Consumes raw radio/serial bytes in chunks of any size and emits every
+// valid command frame as a msg::cmd. Frame layout (multi-byte fields
+// little-endian except the CRC, which is sent MSB first):
+//
+//   | 0xEB 0x90 | len | cmd id | arg (int32) | crc16 |
+//     sync word   1 B    1 B       4 B          2 B
+//
+// len counts the bytes between itself and the CRC (5 for a command).
+// The CRC is CRC-16/CCITT-FALSE over len and the payload.
+//
+// The parser is a byte-at-a-time state machine with a fixed frame buffer:
+// no heap use and bounded work per byte. When a candidate frame fails its
+// length or CRC check, only the bytes of that candidate after its sync
+// word are rescanned for a new sync word, so a corrupted frame cannot hide
+// a real one that starts inside it.
+class UplinkParser {
+    public:
+        static constexpr uint8_t SYNC_0 = 0xEB;
+        static constexpr uint8_t SYNC_1 = 0x90;
+        static constexpr uint8_t CMD_PAYLOAD_LEN = 5;
+        static constexpr size_t CMD_FRAME_LEN = 2 + 1 + CMD_PAYLOAD_LEN + 2;
+        static constexpr size_t MAX_FRAME_LEN = CMD_FRAME_LEN; // Only command frames so far
+
+        // Called for every validated command, returns false if it was dropped
+        using Sink = bool (*)(const msg::cmd& c, void* ctx);
+
+        struct Stats {
+            uint32_t frames;       // Valid commands decoded
+            uint32_t crcErrors;    // Candidates with a bad CRC
+            uint32_t lengthErrors; // Candidates with an impossible len or unknown cmd id
+            uint32_t skippedBytes; // Bytes discarded while hunting for sync
+            uint32_t sinkDrops;    // Valid commands the sink refused (e.g. CMD topic full)
+        };
+
+        // Default sink publishes on the CMD topic without blocking
+        UplinkParser();
+        UplinkParser(Sink sink, void* ctx);
+
+        // Feeds a chunk of bytes, returns the number of commands decoded
+        size_t Feed(const uint8_t* data, size_t len);
+        void Reset();
+
+        const Stats& GetStats() const { return stats_; }
+
+        // Builds a frame for c into out (CMD_FRAME_LEN bytes), returns its length
+        static size_t Encode(const msg::cmd& c, uint8_t* out);
+
+    private:
+        enum class State : uint8_t { SYNC_0, SYNC_1, LEN, PAYLOAD, CRC_HI, CRC_LO };
+
+        size_t Step(uint8_t byte);
+        size_t Complete(uint16_t rxCrc);
+        size_t Resync();
+
+        Sink sink_;
+        void* ctx_;
+        State state_ = State::SYNC_0;
+        uint8_t frame_[MAX_FRAME_LEN];  // Candidate frame, from its sync word on
+        size_t frameLen_ = 0;
+        uint8_t payloadLen_ = 0;
+        uint16_t crc_ = 0;
+        uint8_t crcHi_ = 0;
+        Stats stats_ = {};
+};
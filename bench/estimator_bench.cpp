@@ -0,0 +1,68 @@
+// Cost of one Estimator step: attitude + vertical predict, accelerometer
+// update every sample and a baro update every 20th, as in flight at 1 kHz.
+//
+// Reports ns/step and how much of the 1 ms budget one core spends on it.
+//
+// usage: estimator_bench [steps]   (default 1000000)
+
+#include "apps/Estimator/estimator.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+constexpr double BUDGET_NS = 1e6;   // 1 kHz loop
+constexpr int BARO_DIVIDER = 20;    // 50 Hz baro
+
+// Slowly coning, climbing vehicle so the trig and the gates see real work
+msg::imu Sample(int i) {
+    const float t = i * 0.001f;
+    const float roll = 0.2f * std::sin(0.5f * t);
+    const float pitch = 0.1f * std::cos(0.3f * t);
+    msg::imu m{};
+    m.ax = Estimator::GRAVITY * std::sin(pitch);
+    m.ay = -Estimator::GRAVITY * std::sin(roll) * std::cos(pitch);
+    m.az = -Estimator::GRAVITY * std::cos(roll) * std::cos(pitch) - 0.5f;
+    m.gx = 0.1f * std::cos(0.5f * t);
+    m.gy = -0.03f * std::sin(0.3f * t);
+    m.gz = 0.05f;
+    m.ms = static_cast<uint32_t>(i);
+    return m;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int steps = argc > 1 ? std::atoi(argv[1]) : 1000000;
+
+    // Inputs are generated up front so only the filter is timed
+    static msg::imu samples[4096];
+    for (int i = 0; i < 4096; ++i) samples[i] = Sample(i);
+
+    Estimator est;
+    msg::baro baro{101325.0f, 20.0f, 0};
+    volatile float sink = 0.0f;
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < steps; ++i) {
+        msg::imu m = samples[i & 4095];
+        m.ms = static_cast<uint32_t>(i);
+        est.Predict(m);
+        if (i % BARO_DIVIDER == 0) {
+            baro.pressure_pa = 101325.0f - 0.06f * (i / BARO_DIVIDER);
+            baro.ms = m.ms;
+            est.UpdateBaro(baro);
+        }
+    }
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    sink = est.Estimate().roll;
+    (void)sink;
+
+    double nsPerStep = secs * 1e9 / steps;
+    std::printf("estimator  %9.1f ns/step  %10.0f steps/s  %.3f%% of a 1 kHz core  (%.0fx margin)\n",
+                nsPerStep, steps / secs, nsPerStep / BUDGET_NS * 100.0, BUDGET_NS / nsPerStep);
+    return 0;
+}
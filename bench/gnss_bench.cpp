@@ -0,0 +1,138 @@
+// GNSS ingest cost on a receiver log.
+//
+// The log replays 60 s of a u-blox style 25 Hz stream: every epoch has
+// GNGGA, GNRMC, GNGSA, three GPGSV sentences and a UBX-NAV-PVT frame,
+// like a receiver configured for both NMEA and UBX output. It is parsed
+// once by GnssParser and once by a conventional std::string + strtod
+// splitter (GGA only) for comparison. Reports MB/s and the share of one
+// core needed at 921600 baud.
+//
+// usage: gnss_bench [passes]   (default 20)
+
+#include "apps/Gnss/gnss_parser.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int RATE_HZ = 25;
+constexpr int SECONDS = 60;
+constexpr double LINK_BYTES_PER_SEC = 921600.0 / 10.0;   // 8N1
+
+void AppendSentence(std::vector<uint8_t>& log, const char* body) {
+    char line[128];
+    int n = std::snprintf(line, sizeof(line), "$%s*%02X\r\n", body,
+                          GnssParser::NmeaChecksum(body, std::strlen(body)));
+    log.insert(log.end(), line, line + n);
+}
+
+void PutI32(uint8_t* p, int32_t v) {
+    for (int i = 0; i < 4; ++i) p[i] = static_cast<uint8_t>(static_cast<uint32_t>(v) >> (8 * i));
+}
+
+std::vector<uint8_t> BuildLog() {
+    std::vector<uint8_t> log;
+    char body[128];
+    for (int i = 0; i < RATE_HZ * SECONDS; ++i) {
+        const double t = static_cast<double>(i) / RATE_HZ;
+        const double lat = 48.1173 + 1e-5 * t;
+        const double lon = 11.5166 + 2e-5 * std::sin(0.1 * t);
+        const double alt = 545.4 + 0.5 * t;
+        const int hh = 12, mm = 35 + static_cast<int>(t) / 60, ss = static_cast<int>(t) % 60;
+        const int cs = static_cast<int>((t - std::floor(t)) * 100);
+
+        const double latMin = (lat - std::floor(lat)) * 60.0;
+        const double lonMin = (lon - std::floor(lon)) * 60.0;
+        std::snprintf(body, sizeof(body), "GNGGA,%02d%02d%02d.%02d,%02d%08.5f,N,%03d%08.5f,E,1,12,0.8,%.1f,M,46.9,M,,",
+                      hh, mm, ss, cs, static_cast<int>(lat), latMin, static_cast<int>(lon), lonMin, alt);
+        AppendSentence(log, body);
+        std::snprintf(body, sizeof(body), "GNRMC,%02d%02d%02d.%02d,A,%02d%08.5f,N,%03d%08.5f,E,0.12,84.4,161026,,,A",
+                      hh, mm, ss, cs, static_cast<int>(lat), latMin, static_cast<int>(lon), lonMin);
+        AppendSentence(log, body);
+        AppendSentence(log, "GNGSA,A,3,02,05,07,09,13,15,20,30,,,,,1.4,0.8,1.1,1");
+        AppendSentence(log, "GPGSV,3,1,11,02,45,123,42,05,67,045,45,07,12,310,33,09,30,270,38,1");
+        AppendSentence(log, "GPGSV,3,2,11,13,55,180,44,15,20,080,36,18,05,350,,20,40,220,40,1");
+        AppendSentence(log, "GPGSV,3,3,11,25,03,010,,29,08,150,,30,62,300,46,1");
+
+        uint8_t pvt[GnssParser::NAV_PVT_LEN] = {};
+        pvt[20] = 3;
+        pvt[21] = 0x01;
+        pvt[23] = 12;
+        PutI32(pvt + 24, static_cast<int32_t>(lon * 1e7));
+        PutI32(pvt + 28, static_cast<int32_t>(lat * 1e7));
+        PutI32(pvt + 36, static_cast<int32_t>(alt * 1e3));
+        uint8_t frame[GnssParser::NAV_PVT_LEN + 8];
+        size_t len = GnssParser::EncodeUbx(GnssParser::UBX_CLASS_NAV, GnssParser::UBX_ID_NAV_PVT,
+                                           pvt, GnssParser::NAV_PVT_LEN, frame);
+        log.insert(log.end(), frame, frame + len);
+    }
+    return log;
+}
+
+bool CountFix(const msg::gnss&, void* ctx) {
+    ++*static_cast<size_t*>(ctx);
+    return true;
+}
+
+// Conventional approach: build lines as std::string, split, strtod
+size_t NaiveParse(const std::vector<uint8_t>& log, double& sink) {
+    size_t fixes = 0;
+    std::string line;
+    for (uint8_t b : log) {
+        if (b == '$') { line.clear(); continue; }
+        if (b != '\n') { line.push_back(static_cast<char>(b)); continue; }
+        if (line.compare(2, 3, "GGA") != 0) continue;
+        std::vector<std::string> fields;
+        size_t start = 0, comma;
+        while ((comma = line.find(',', start)) != std::string::npos) {
+            fields.push_back(line.substr(start, comma - start));
+            start = comma + 1;
+        }
+        if (fields.size() < 10) continue;
+        double ddmm = std::strtod(fields[2].c_str(), nullptr);
+        double lat = std::floor(ddmm / 100) + std::fmod(ddmm, 100.0) / 60.0;
+        double alt = std::strtod(fields[9].c_str(), nullptr);
+        sink += lat + alt;
+        fixes++;
+    }
+    return fixes;
+}
+
+void Report(const char* name, double secs, size_t bytes, size_t fixes) {
+    const double bytesPerSec = bytes / secs;
+    std::printf("%-12s %8.1f MB/s  %6.2f ns/byte  %8zu fixes  %.4f%% CPU @ 921600 baud\n",
+                name, bytesPerSec / 1e6, secs * 1e9 / bytes, fixes, LINK_BYTES_PER_SEC / bytesPerSec * 100.0);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const int passes = argc > 1 ? std::atoi(argv[1]) : 20;
+    const std::vector<uint8_t> log = BuildLog();
+    std::printf("log: %zu bytes, %d epochs at %d Hz, %.0f%% of a 921600 baud link\n",
+                log.size(), RATE_HZ * SECONDS, RATE_HZ, log.size() / (LINK_BYTES_PER_SEC * SECONDS) * 100.0);
+
+    size_t fixes = 0;
+    GnssParser parser(CountFix, &fixes);
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < passes; ++i) parser.Feed(log.data(), log.size());
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Report("GnssParser", secs, log.size() * passes, fixes);
+
+    double sink = 0.0;
+    size_t naiveFixes = 0;
+    start = std::chrono::steady_clock::now();
+    for (int i = 0; i < passes; ++i) naiveFixes += NaiveParse(log, sink);
+    secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    Report("string+strtod", secs, log.size() * passes, naiveFixes);
+
+    const GnssParser::Stats& st = parser.GetStats();
+    std::printf("checksum errors %u, ignored %u  (checksum %g)\n", st.checksumErrors, st.ignored, sink);
+    return st.checksumErrors == 0 ? 0 : 1;
+}
@@ -0,0 +1,98 @@
+// Compression ratio and speed of the IMU telemetry compressor.
+//
+// Synthesizes a 1 kHz IMU stream (gravity, slow rotation, vibration and
+// sensor noise), compresses it in blocks, decodes it again and reports
+// bytes per sample, ratio vs raw msg::imu, encode/decode samples/s and
+// the worst reconstruction error.
+
+#include "apps/TelemetryManager/imu_compressor.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace {
+
+std::vector<msg::imu> MakeStream(size_t n, float noiseScale) {
+    std::mt19937 rng(42);
+    std::normal_distribution<float> accelNoise(0.0f, 0.02f * noiseScale);   // m/s^2
+    std::normal_distribution<float> gyroNoise(0.0f, 0.002f * noiseScale);   // rad/s
+
+    std::vector<msg::imu> out(n);
+    for (size_t i = 0; i < n; ++i) {
+        float t = i * 0.001f;
+        msg::imu& s = out[i];
+        s.ax = 0.3f * std::sin(0.5f * t) + 0.05f * std::sin(2 * 3.14159f * 35.0f * t) + accelNoise(rng);
+        s.ay = 0.2f * std::cos(0.3f * t) + accelNoise(rng);
+        s.az = 9.81f + 0.1f * std::sin(1.1f * t) + accelNoise(rng);
+        s.gx = 0.1f * std::sin(0.7f * t) + gyroNoise(rng);
+        s.gy = 0.05f * std::cos(0.2f * t) + gyroNoise(rng);
+        s.gz = 0.5f + gyroNoise(rng);   // Slow spin
+        s.ms = static_cast<uint32_t>(i);
+    }
+    return out;
+}
+
+void Run(const char* label, float noiseScale, size_t block) {
+    constexpr size_t SAMPLES = 1000000;
+    const auto stream = MakeStream(SAMPLES, noiseScale);
+    ImuCompressor compressor;
+
+    std::vector<uint8_t> packed(ImuCompressor::MaxBlockBytes(block) * (SAMPLES / block + 1));
+    std::vector<size_t> blockBytes;
+    blockBytes.reserve(SAMPLES / block + 1);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t bytes = 0;
+    for (size_t i = 0; i < SAMPLES; i += block) {
+        size_t n = std::min(block, SAMPLES - i);
+        size_t len = compressor.EncodeBlock(&stream[i], n, packed.data() + bytes, packed.size() - bytes);
+        blockBytes.push_back(len);
+        bytes += len;
+    }
+    double encodeSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::vector<msg::imu> decoded(SAMPLES);
+    start = std::chrono::steady_clock::now();
+    size_t pos = 0, out = 0;
+    for (size_t len : blockBytes) {
+        out += compressor.DecodeBlock(packed.data() + pos, len, &decoded[out]);
+        pos += len;
+    }
+    double decodeSecs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    float maxAccelErr = 0, maxGyroErr = 0;
+    bool timeOk = out == SAMPLES;
+    for (size_t i = 0; i < out; ++i) {
+        const msg::imu& a = stream[i];
+        const msg::imu& b = decoded[i];
+        maxAccelErr = std::fmax(maxAccelErr, std::fabs(a.ax - b.ax));
+        maxAccelErr = std::fmax(maxAccelErr, std::fabs(a.ay - b.ay));
+        maxAccelErr = std::fmax(maxAccelErr, std::fabs(a.az - b.az));
+        maxGyroErr = std::fmax(maxGyroErr, std::fabs(a.gx - b.gx));
+        maxGyroErr = std::fmax(maxGyroErr, std::fabs(a.gy - b.gy));
+        maxGyroErr = std::fmax(maxGyroErr, std::fabs(a.gz - b.gz));
+        timeOk = timeOk && a.ms == b.ms;
+    }
+
+    double perSample = static_cast<double>(bytes) / SAMPLES;
+    std::printf("%-7s block %2zu: %5.2f B/sample, ratio %4.2fx, encode %6.2f M samples/s, "
+                "decode %6.2f M samples/s, max err %.5f m/s^2 %.6f rad/s%s\n",
+                label, block, perSample, sizeof(msg::imu) / perSample,
+                SAMPLES / encodeSecs / 1e6, SAMPLES / decodeSecs / 1e6,
+                maxAccelErr, maxGyroErr, timeOk ? "" : "  TIMESTAMP MISMATCH");
+}
+
+} // namespace
+
+int main() {
+    std::printf("[imu_compression_bench] raw msg::imu is %zu bytes\n", sizeof(msg::imu));
+    for (size_t block : {8, 16, 32}) {
+        Run("quiet", 0.5f, block);
+        Run("nominal", 1.0f, block);
+        Run("noisy", 4.0f, block);
+    }
+    return 0;
+}
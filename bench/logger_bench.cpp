@@ -0,0 +1,101 @@
+// Cost of a log call on the calling task.
+//
+// Logs a typical three-argument telemetry line in runs of RING_DEPTH
+// calls, flushing to a null sink between runs outside the timed region,
+// so only the hot path is measured: timestamp, argument packing and the
+// ring push. For comparison the same line is formatted in place with
+// snprintf and written with fwrite under a mutex, which is what a task
+// printing to a shared console pays. Also reports the drain-side cost of
+// formatting one record.
+//
+// usage: logger_bench [runs]   (default 2000)
+
+#include "apps/Logger/logger.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double NsSince(Clock::time_point start) {
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+void NullSink(const char*, size_t) {}
+
+volatile int g_value = 0;   // Keeps the arguments from being constant-folded
+
+}
+
+int main(int argc, char** argv) {
+    const int runs = argc > 1 ? std::atoi(argv[1]) : 2000;
+    const size_t perRun = Logger::RING_DEPTH;
+    const double calls = static_cast<double>(runs) * perRun;
+    Logger::SetSink(NullSink);
+
+    // Deferred logger: hot path only
+    double loggerNs = 0;
+    for (int r = 0; r < runs; ++r) {
+        const auto start = Clock::now();
+        for (size_t i = 0; i < perRun; ++i) {
+            Logger::Info("[Estimator] alt=%.2f vz=%.2f state=%d", 101.5 + i, -3.25, g_value);
+        }
+        loggerNs += NsSince(start);
+        Logger::Flush();
+    }
+
+    // Filtered out by level: the cost of a disabled debug line
+    Logger::SetLevel(Logger::INFO);
+    auto start = Clock::now();
+    for (size_t i = 0; i < perRun * 100; ++i) {
+        Logger::Debug("[Estimator] alt=%.2f vz=%.2f state=%d", 101.5 + i, -3.25, g_value);
+    }
+    const double filteredNs = NsSince(start) / (perRun * 100);
+    Logger::SetLevel(Logger::DEBUG);
+
+    // Drain side: formatting one record
+    Logger::Record rec{};
+    rec.fmt = "[Estimator] alt=%.2f vz=%.2f state=%d";
+    rec.level = Logger::INFO;
+    rec.count = 3;
+    rec.types[0] = rec.types[1] = Logger::DOUBLE;
+    rec.types[2] = Logger::INT;
+    rec.args[0].d = 101.5;
+    rec.args[1].d = -3.25;
+    rec.args[2].i = 2;
+    char line[Logger::MAX_LINE];
+    size_t sink = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < perRun * 100; ++i) sink += Logger::Format(rec, line, sizeof(line));
+    const double formatNs = NsSince(start) / (perRun * 100);
+
+    // Baseline: format and write on the calling task, console guarded by a mutex
+    FILE* devNull = std::fopen("/dev/null", "w");
+    if (!devNull) return 1;
+    Rtos::Mutex console;
+    double directNs = 0;
+    for (int r = 0; r < runs; ++r) {
+        start = Clock::now();
+        for (size_t i = 0; i < perRun; ++i) {
+            const int n = std::snprintf(line, sizeof(line), "[Estimator] alt=%.2f vz=%.2f state=%d",
+                                        101.5 + i, -3.25, g_value);
+            console.lock();
+            std::fwrite(line, 1, static_cast<size_t>(n), devNull);
+            std::fputc('\n', devNull);
+            console.unlock();
+        }
+        directNs += NsSince(start);
+        std::fflush(devNull);
+    }
+    std::fclose(devNull);
+
+    std::printf("Logger hot path   : %7.1f ns/call  (%d runs x %zu calls)\n", loggerNs / calls, runs, perRun);
+    std::printf("Filtered by level : %7.1f ns/call\n", filteredNs);
+    std::printf("Drain formatting  : %7.1f ns/record (%zu bytes)\n", formatNs, sink / (perRun * 100));
+    std::printf("snprintf + fwrite : %7.1f ns/call  (%.1fx the logger)\n", directNs / calls, directNs / loggerNs);
+    std::printf("Records dropped   : %llu\n", static_cast<unsigned long long>(Logger::Dropped()));
+    return 0;
+}
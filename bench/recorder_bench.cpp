@@ -0,0 +1,134 @@
+// Flight recorder write throughput.
+//
+// Appends msg::imu records to a FlightLog in a memory-mapped persistent
+// region, with a sync point (data msync, then header) every SYNC_EVERY
+// records, as the recorder does at full sensor rate. Reports
+// MB/s, ns per record, sync latency and the headroom over a 1 kHz IMU
+// stream. For comparison the same records are written with fwrite and
+// made durable with fflush + fdatasync at the same points.
+//
+// usage: recorder_bench [records] [file]   (default 1000000, recorder_bench.rec)
+
+#include "apps/FlightRecorder/flight_log.hpp"
+#include "msg/messages.hpp"
+#include "os/rtos.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <unistd.h>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t SYNC_EVERY = 500;            // ~0.5 s of IMU at 1 kHz
+constexpr double IMU_RATE_HZ = 1000.0;
+constexpr uint8_t IMU_TYPE = 1;
+
+double SecondsSince(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+msg::imu Sample(uint32_t i) {
+    return msg::imu{0.1f * i, 0.2f, 9.81f, 0.01f, -0.02f, 0.03f, i};
+}
+
+struct SyncStats {
+    double totalUs = 0;
+    double maxUs = 0;
+    size_t count = 0;
+
+    void Add(double us) {
+        totalUs += us;
+        if (us > maxUs) maxUs = us;
+        count++;
+    }
+};
+
+}
+
+int main(int argc, char** argv) {
+    const size_t records = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 1000000;
+    const char* path = argc > 2 ? argv[2] : "recorder_bench.rec";
+    const size_t recordLen = FlightLog::RECORD_HEADER_LEN + sizeof(msg::imu);
+    const size_t size = FlightLog::HEADER_AREA + (records + records / SYNC_EVERY + 16) * (recordLen + 48);
+    const double mb = static_cast<double>(records * recordLen) / 1e6;
+
+    //-- Mapped log --//
+    std::remove(path);
+    Rtos::PersistentRegion region;
+    if (!region.open(path, size)) return 1;
+    FlightLog::Writer log(region.data(), region.size());
+    log.Open(true);
+
+    SyncStats mappedSync;
+    double appendSeconds = 0;
+    const auto start = Clock::now();
+    for (size_t i = 0; i < records; i += SYNC_EVERY) {
+        const auto batch = Clock::now();
+        const size_t end = i + SYNC_EVERY < records ? i + SYNC_EVERY : records;
+        for (size_t j = i; j < end; ++j) log.Append(IMU_TYPE, j, Sample(static_cast<uint32_t>(j)));
+        appendSeconds += SecondsSince(batch);
+
+        const auto sync = Clock::now();
+        const FlightLog::Range data = log.BeginSync(end, 0);
+        region.sync(data.offset, data.len);
+        const FlightLog::Range header = log.EndSync();
+        region.sync(header.offset, header.len);
+        mappedSync.Add(SecondsSince(sync) * 1e6);
+    }
+    const double mappedSeconds = SecondsSince(start);
+
+    // Read back, so the numbers are for a log that actually checks out
+    FlightLog::Reader reader(region.data(), region.size());
+    reader.Open();
+    FlightLog::Record rec;
+    size_t readBack = 0;
+    const auto readStart = Clock::now();
+    while (reader.Next(rec)) {
+        if (rec.type == IMU_TYPE) readBack++;
+    }
+    const double readSeconds = SecondsSince(readStart);
+    region.close();
+    std::remove(path);
+
+    //-- Baseline: stdio + fdatasync --//
+    FILE* f = std::fopen(path, "wb");
+    if (!f) return 1;
+    uint8_t buf[64];
+    SyncStats stdioSync;
+    const auto stdioStart = Clock::now();
+    for (size_t i = 0; i < records; i += SYNC_EVERY) {
+        const size_t end = i + SYNC_EVERY < records ? i + SYNC_EVERY : records;
+        for (size_t j = i; j < end; ++j) {
+            const msg::imu m = Sample(static_cast<uint32_t>(j));
+            const uint64_t us = j;
+            buf[0] = IMU_TYPE;
+            buf[1] = sizeof(m);
+            std::memcpy(buf + 4, &us, sizeof(us));
+            std::memcpy(buf + FlightLog::RECORD_HEADER_LEN, &m, sizeof(m));
+            std::fwrite(buf, 1, recordLen, f);
+        }
+        const auto sync = Clock::now();
+        std::fflush(f);
+        fdatasync(fileno(f));
+        stdioSync.Add(SecondsSince(sync) * 1e6);
+    }
+    const double stdioSeconds = SecondsSince(stdioStart);
+    std::fclose(f);
+    std::remove(path);
+
+    const double perRecordNs = appendSeconds * 1e9 / records;
+    std::printf("Records           : %zu x %zu B (%.1f MB), sync every %zu\n", records, recordLen, mb, SYNC_EVERY);
+    std::printf("Mapped append     : %7.1f ns/record, %8.1f MB/s (no syncs)\n", perRecordNs, mb / appendSeconds);
+    std::printf("Mapped + syncs    : %8.1f MB/s, sync avg %.0f us, max %.0f us\n",
+                mb / mappedSeconds, mappedSync.totalUs / mappedSync.count, mappedSync.maxUs);
+    std::printf("stdio + fdatasync : %8.1f MB/s, sync avg %.0f us, max %.0f us\n",
+                mb / stdioSeconds, stdioSync.totalUs / stdioSync.count, stdioSync.maxUs);
+    std::printf("Read back         : %zu records, %.1f MB/s\n", readBack, mb / readSeconds);
+    std::printf("Headroom          : %.0fx a %.0f Hz IMU stream\n",
+                records / mappedSeconds / IMU_RATE_HZ, IMU_RATE_HZ);
+    return readBack == records ? 0 : 1;
+}
@@ -0,0 +1,435 @@
+// Micro-benchmarks for the OSAL IPC primitives.
+//
+// Measures throughput (msgs/s) and latency percentiles for the queues,
+// mailbox, semaphores and mutex in os/rtos.hpp across payload sizes, task counts
+// and blocking vs try_ variants. Results are printed as a table and
+// written as CSV so runs can be diffed between commits.
+//
+// usage: rtos_bench [output.csv] [scale]
+//   scale multiplies the iteration counts (default 1.0)
+
+#include "os/rtos.hpp"
+#include "msg/messages.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t BENCH_QUEUE_DEPTH = 16;
+
+struct Blob4k {
+    uint8_t data[4096];
+};
+
+template <typename T> const char* PayloadName();
+template <> const char* PayloadName<int>() { return "int"; }
+template <> const char* PayloadName<msg::imu>() { return "msg::imu"; }
+template <> const char* PayloadName<Blob4k>() { return "4KB"; }
+
+inline uint64_t NowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        Clock::now().time_since_epoch()).count();
+}
+
+//== Results ==//
+
+struct Result {
+    std::string bench;      // "throughput" or "latency"
+    std::string primitive;
+    std::string payload;
+    int producers;
+    int consumers;
+    std::string mode;       // "blocking", "try", "batchN" or "loan"
+    uint64_t ops;
+    double opsPerSec;
+    // Latency percentiles in ns, 0 when not measured
+    uint64_t p50, p99, p999, max;
+};
+
+std::vector<Result> g_results;
+double g_scale = 1.0;
+
+uint64_t Scaled(uint64_t n) {
+    auto v = static_cast<uint64_t>(n * g_scale);
+    return v > 0 ? v : 1;
+}
+
+void Record(Result r) {
+    std::printf("%-10s %-18s %-9s %dp/%dc %-8s %10.0f ops/s",
+                r.bench.c_str(), r.primitive.c_str(), r.payload.c_str(),
+                r.producers, r.consumers, r.mode.c_str(), r.opsPerSec);
+    if (r.max > 0) {
+        std::printf("  p50 %6llu  p99 %7llu  p99.9 %7llu  max %8llu ns",
+                    (unsigned long long)r.p50, (unsigned long long)r.p99,
+                    (unsigned long long)r.p999, (unsigned long long)r.max);
+    }
+    std::printf("\n");
+    g_results.push_back(std::move(r));
+}
+
+// Fills in percentiles from a set of per-operation samples (ns)
+void Percentiles(std::vector<uint64_t>& samples, Result& r) {
+    if (samples.empty()) return;
+    std::sort(samples.begin(), samples.end());
+    auto at = [&](double q) {
+        size_t i = static_cast<size_t>(q * (samples.size() - 1));
+        return samples[i];
+    };
+    r.p50 = at(0.50);
+    r.p99 = at(0.99);
+    r.p999 = at(0.999);
+    r.max = samples.back();
+}
+
+bool WriteCsv(const char* path) {
+    FILE* f = std::fopen(path, "w");
+    if (!f) return false;
+    std::fprintf(f, "bench,primitive,payload,producers,consumers,mode,ops,ops_per_sec,p50_ns,p99_ns,p999_ns,max_ns\n");
+    for (const auto& r : g_results) {
+        std::fprintf(f, "%s,%s,%s,%d,%d,%s,%llu,%.1f,%llu,%llu,%llu,%llu\n",
+                     r.bench.c_str(), r.primitive.c_str(), r.payload.c_str(),
+                     r.producers, r.consumers, r.mode.c_str(),
+                     (unsigned long long)r.ops, r.opsPerSec,
+                     (unsigned long long)r.p50, (unsigned long long)r.p99,
+                     (unsigned long long)r.p999, (unsigned long long)r.max);
+    }
+    std::fclose(f);
+    return true;
+}
+
+//== Task helpers ==//
+
+// Runs fn(i) on n OSAL tasks released together, returns wall time in s
+template <typename Fn>
+double RunTasks(int n, Fn fn) {
+    struct Ctx {
+        Fn* fn;
+        int index;
+        std::atomic<bool>* go;
+    };
+    std::atomic<bool> go{false};
+    std::vector<Ctx> ctx(n);
+    std::vector<Rtos::Task> tasks(n);
+
+    for (int i = 0; i < n; ++i) {
+        ctx[i] = Ctx{&fn, i, &go};
+        tasks[i].Create("bench", [](void* arg) {
+            auto* c = static_cast<Ctx*>(arg);
+            while (!c->go->load(std::memory_order_acquire)) std::this_thread::yield();
+            (*c->fn)(c->index);
+        }, &ctx[i]);
+    }
+
+    auto start = Clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& t : tasks) t.Join();
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <typename Q, typename T>
+void Send(Q& q, const T& item, bool blocking) {
+    if (blocking) {
+        q.send(item, Rtos::MAX_TIMEOUT);
+    } else {
+        while (!q.try_send(item)) std::this_thread::yield();
+    }
+}
+
+template <typename Q, typename T>
+void Receive(Q& q, T& item, bool blocking) {
+    if (blocking) {
+        q.receive(item, Rtos::MAX_TIMEOUT);
+    } else {
+        while (!q.try_receive(item)) std::this_thread::yield();
+    }
+}
+
+//== Queue benchmarks ==//
+
+// Producers push total msgs split evenly, consumers pop their share
+template <typename Q, typename T>
+void QueueThroughput(const char* name, int producers, int consumers,
+                     bool blocking, uint64_t total) {
+    total -= total % (producers * consumers);
+    auto* q = new Q();
+    const uint64_t perProducer = total / producers;
+    const uint64_t perConsumer = total / consumers;
+
+    double secs = RunTasks(producers + consumers, [&](int i) {
+        T item{};
+        if (i < producers) {
+            for (uint64_t n = 0; n < perProducer; ++n) Send(*q, item, blocking);
+        } else {
+            for (uint64_t n = 0; n < perConsumer; ++n) Receive(*q, item, blocking);
+        }
+    });
+    delete q;
+
+    Record(Result{"throughput", name, PayloadName<T>(), producers, consumers,
+                  blocking ? "blocking" : "try", total, total / secs, 0, 0, 0, 0});
+}
+
+// Ping-pong over two queues, one-way latency = round trip / 2
+template <typename Q, typename T>
+void QueueLatency(const char* name, bool blocking, uint64_t iterations) {
+    auto* ping = new Q();
+    auto* pong = new Q();
+    std::vector<uint64_t> samples;
+    samples.reserve(iterations);
+
+    double secs = RunTasks(2, [&](int i) {
+        T item{};
+        if (i == 0) {
+            for (uint64_t n = 0; n < iterations; ++n) {
+                uint64_t t0 = NowNs();
+                Send(*ping, item, blocking);
+                Receive(*pong, item, blocking);
+                samples.push_back((NowNs() - t0) / 2);
+            }
+        } else {
+            for (uint64_t n = 0; n < iterations; ++n) {
+                Receive(*ping, item, blocking);
+                Send(*pong, item, blocking);
+            }
+        }
+    });
+    delete ping;
+    delete pong;
+
+    Result r{"latency", name, PayloadName<T>(), 1, 1, blocking ? "blocking" : "try",
+             iterations, 2.0 * iterations / secs, 0, 0, 0, 0};
+    Percentiles(samples, r);
+    Record(r);
+}
+
+// Same as QueueThroughput(1p/1c) but moving runs with send_n/receive_n
+template <typename Q, typename T>
+void QueueBatchThroughput(const char* name, size_t batch, uint64_t total) {
+    total -= total % batch;
+    auto* q = new Q();
+
+    double secs = RunTasks(2, [&](int i) {
+        std::vector<T> local(batch);
+        uint64_t moved = 0;
+        while (moved < total) {
+            if (i == 0) moved += q->send_n(local.data(), batch, Rtos::MAX_TIMEOUT);
+            else moved += q->receive_n(local.data(), batch, Rtos::MAX_TIMEOUT);
+        }
+    });
+    delete q;
+
+    Record(Result{"throughput", name, PayloadName<T>(), 1, 1,
+                  "batch" + std::to_string(batch), total, total / secs, 0, 0, 0, 0});
+}
+
+// 1p/1c through the zero-copy acquire_slot/commit, peek_front/release path
+template <typename T>
+void QueueLoanThroughput(uint64_t total) {
+    auto* q = new Rtos::Queue<T, BENCH_QUEUE_DEPTH>();
+
+    double secs = RunTasks(2, [&](int i) {
+        for (uint64_t n = 0; n < total; ++n) {
+            if (i == 0) {
+                T* slot = q->acquire_slot(Rtos::MAX_TIMEOUT);
+                reinterpret_cast<volatile uint8_t*>(slot)[0] = static_cast<uint8_t>(n);
+                q->commit();
+            } else {
+                const T* item = q->peek_front(Rtos::MAX_TIMEOUT);
+                (void)reinterpret_cast<const volatile uint8_t*>(item)[0];
+                q->release();
+            }
+        }
+    });
+    delete q;
+
+    Record(Result{"throughput", "Queue", PayloadName<T>(), 1, 1, "loan", total, total / secs, 0, 0, 0, 0});
+}
+
+template <typename T>
+void QueueSuite(uint64_t msgs) {
+    using Locked = Rtos::Queue<T, BENCH_QUEUE_DEPTH>;
+    using Spsc = Rtos::SpscQueue<T, BENCH_QUEUE_DEPTH>;
+    using Mpmc = Rtos::MpmcQueue<T, BENCH_QUEUE_DEPTH>;
+    const uint64_t pings = msgs / 10;
+
+    for (bool blocking : {true, false}) {
+        QueueThroughput<Locked, T>("Queue", 1, 1, blocking, msgs);
+        QueueThroughput<Locked, T>("Queue", 4, 2, blocking, msgs);
+        QueueThroughput<Spsc, T>("SpscQueue", 1, 1, blocking, msgs);
+        QueueThroughput<Mpmc, T>("MpmcQueue", 1, 1, blocking, msgs);
+        QueueThroughput<Mpmc, T>("MpmcQueue", 4, 2, blocking, msgs);
+
+        QueueLatency<Locked, T>("Queue", blocking, pings);
+        QueueLatency<Spsc, T>("SpscQueue", blocking, pings);
+        QueueLatency<Mpmc, T>("MpmcQueue", blocking, pings);
+    }
+
+    QueueBatchThroughput<Locked, T>("Queue", 10, msgs);
+    QueueBatchThroughput<Spsc, T>("SpscQueue", 10, msgs);
+    QueueLoanThroughput<T>(msgs);
+}
+
+//== Latest-value benchmarks ==//
+
+// One task keeps overwriting the value while the other fetches the newest
+// copy. The Queue reader has to drain stale entries to get there.
+template <typename T>
+void LatestValueSuite(uint64_t reads) {
+    for (int kind = 0; kind < 2; ++kind) {
+        Rtos::Mailbox<T> box;
+        Rtos::Queue<T, BENCH_QUEUE_DEPTH> queue(true);
+        std::atomic<bool> stop{false};
+        std::vector<uint64_t> samples(reads);
+
+        double secs = RunTasks(2, [&](int i) {
+            T value{};
+            if (i == 0) {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    if (kind == 0) box.write(value);
+                    else queue.send(value);
+                }
+                return;
+            }
+            for (uint64_t n = 0; n < reads; ++n) {
+                uint64_t t0 = NowNs();
+                if (kind == 0) box.read(value);
+                else while (queue.try_receive(value)) {}
+                samples[n] = NowNs() - t0;
+            }
+            stop.store(true, std::memory_order_relaxed);
+        });
+
+        Result r{"latency", kind == 0 ? "Mailbox" : "Queue", PayloadName<T>(), 1, 1,
+                 kind == 0 ? "read" : "drain", reads, reads / secs, 0, 0, 0, 0};
+        Percentiles(samples, r);
+        Record(r);
+    }
+}
+
+//== Semaphore and mutex benchmarks ==//
+
+// Two tasks hand a token back and forth through a pair of semaphores
+template <typename Sem>
+void SemaphorePingPong(const char* name, Sem& a, Sem& b, bool blocking, uint64_t iterations) {
+    auto take = [blocking](Sem& s) {
+        if (blocking) s.take();
+        else while (!s.try_take()) std::this_thread::yield();
+    };
+    std::vector<uint64_t> samples;
+    samples.reserve(iterations);
+
+    double secs = RunTasks(2, [&](int i) {
+        for (uint64_t n = 0; n < iterations; ++n) {
+            if (i == 0) {
+                uint64_t t0 = NowNs();
+                a.give();
+                take(b);
+                samples.push_back((NowNs() - t0) / 2);
+            } else {
+                take(a);
+                b.give();
+            }
+        }
+    });
+
+    Result r{"latency", name, "-", 1, 1, blocking ? "blocking" : "try",
+             iterations, 2.0 * iterations / secs, 0, 0, 0, 0};
+    Percentiles(samples, r);
+    Record(r);
+}
+
+// give/take pairs on a semaphore no other task touches
+template <typename Sem>
+void SemaphoreUncontended(const char* name, Sem& s, uint64_t iterations) {
+    std::vector<uint64_t> samples(iterations);
+    auto start = Clock::now();
+    for (uint64_t n = 0; n < iterations; ++n) {
+        uint64_t t0 = NowNs();
+        s.give();
+        s.try_take();
+        samples[n] = NowNs() - t0;
+    }
+    double secs = std::chrono::duration<double>(Clock::now() - start).count();
+
+    Result r{"latency", name, "-", 1, 0, "uncontended", iterations, iterations / secs, 0, 0, 0, 0};
+    Percentiles(samples, r);
+    Record(r);
+}
+
+// lock/unlock pairs from n tasks on one mutex
+void MutexContended(int tasks, uint64_t iterations) {
+    Rtos::Mutex m;
+    volatile uint64_t shared = 0;
+    std::vector<std::vector<uint64_t>> samples(tasks, std::vector<uint64_t>(iterations));
+
+    double secs = RunTasks(tasks, [&](int i) {
+        for (uint64_t n = 0; n < iterations; ++n) {
+            uint64_t t0 = NowNs();
+            m.lock();
+            shared = shared + 1;
+            m.unlock();
+            samples[i][n] = NowNs() - t0;
+        }
+    });
+
+    std::vector<uint64_t> all;
+    for (auto& s : samples) all.insert(all.end(), s.begin(), s.end());
+    const uint64_t ops = static_cast<uint64_t>(tasks) * iterations;
+    Result r{"latency", "Mutex", "-", tasks, 0, tasks > 1 ? "contended" : "uncontended",
+             ops, ops / secs, 0, 0, 0, 0};
+    Percentiles(all, r);
+    Record(r);
+}
+
+void SyncSuite(uint64_t iterations) {
+    {
+        Rtos::BinarySemaphore s;
+        SemaphoreUncontended("BinarySemaphore", s, iterations);
+    }
+    {
+        Rtos::CountingSemaphore s(1, 0);
+        SemaphoreUncontended("CountingSemaphore", s, iterations);
+    }
+    for (bool blocking : {true, false}) {
+        Rtos::BinarySemaphore a, b;
+        SemaphorePingPong("BinarySemaphore", a, b, blocking, iterations / 10);
+    }
+    for (bool blocking : {true, false}) {
+        Rtos::CountingSemaphore a(1, 0), b(1, 0);
+        SemaphorePingPong("CountingSemaphore", a, b, blocking, iterations / 10);
+    }
+    MutexContended(1, iterations);
+    MutexContended(4, iterations / 4);
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* csvPath = argc > 1 ? argv[1] : "rtos_bench.csv";
+    if (argc > 2) g_scale = std::atof(argv[2]);
+
+    std::printf("[rtos_bench] scale %.2f, queue depth %zu\n", g_scale, BENCH_QUEUE_DEPTH);
+
+    QueueSuite<int>(Scaled(200000));
+    QueueSuite<msg::imu>(Scaled(200000));
+    QueueSuite<Blob4k>(Scaled(20000));
+    LatestValueSuite<msg::imu>(Scaled(200000));
+    SyncSuite(Scaled(200000));
+
+    if (!WriteCsv(csvPath)) {
+        std::fprintf(stderr, "[rtos_bench] Could not write %s\n", csvPath);
+        return 1;
+    }
+    std::printf("[rtos_bench] Wrote %zu results to %s\n", g_results.size(), csvPath);
+    return 0;
+}
@@ -2,6 +2,9 @@
 #include "apps/CommandHandler/command_handler.hpp"
 #include "apps/TelemetryManager/telemetry_manager.hpp"
 #include "apps/Estimator/estimator.hpp"
+#include "apps/TimerService/timer_service.hpp"
+#include "apps/Logger/logger.hpp"
+#include "apps/FlightRecorder/flight_recorder.hpp"
 #include <iostream>
 #include "os/rtos.hpp"
 #include "queues/queues.hpp"
@@ -9,28 +12,56 @@
 // Demo producer task
 void ProducerDemo_Run(void*) {
     msg::cmd c{};
-    c.type = msg::cmd::TX_ON; CmdQueue.send(c,100); Rtos::SleepMs(200);
-    c.type = msg::cmd::ARM;   CmdQueue.send(c,100); Rtos::SleepMs(200);
-    c.type = msg::cmd::TX_ON; CmdQueue.send(c,100); Rtos::SleepMs(200);
-    c.type = msg::cmd::TX_OFF;CmdQueue.send(c,100);
+    c.type = msg::cmd::TX_ON; Bus::Publish<Topics::CMD>(c,100); Rtos::SleepMs(200);
+    c.type = msg::cmd::ARM;   Bus::Publish<Topics::CMD>(c,100); Rtos::SleepMs(200);
+    c.type = msg::cmd::TX_ON; Bus::Publish<Topics::CMD>(c,100); Rtos::SleepMs(200);
+    c.type = msg::cmd::TX_OFF;Bus::Publish<Topics::CMD>(c,100);
 }
 Rtos::Task ProducerTask;
 
-// Rtos::Task StateMachineTask;
+Rtos::Task LoggerTask;
+Rtos::Task FlightRecorderTask;
+Rtos::Task TimerServiceTask;
+Rtos::Task StateMachineTask;
 Rtos::Task CommandHandlerTask;
 // Rtos::Task TelemetryManagerTask;
 // Rtos::Task EstimatorTask;
 
 int main(){
-    // Create tasks
-    // StateMachineTask.Create("StateMachine", StateMachine::Run, nullptr);
+    // Subscribe before the tasks start so no ack is missed
+    Bus::Subscription<Topics::CMD_ACK> acks;
+
+    // Create tasks (logger, recorder and timer service first: the others
+    // log and arm timers). A message published before its consumer has
+    // subscribed is lost, so the producers only start once the recorder,
+    // StateMachine and CommandHandler have subscribed.
+    LoggerTask.Create("Logger", Logger::Run, nullptr);
+    FlightRecorderTask.Create("FlightRecorder", FlightRecorder::Run, nullptr);
+    FlightRecorder::WaitSubscribed(1000);
+    TimerServiceTask.Create("TimerService", TimerService::Run, nullptr);
+    StateMachineTask.Create("StateMachine", StateMachine::Run, nullptr);
     CommandHandlerTask.Create("CommandHandler", CommandHandler::Run, nullptr);
+    StateMachine::WaitSubscribed(1000);
+    CommandHandler::WaitSubscribed(1000);
     // TelemetryManagerTask.Create("TelemetryManager", TelemetryManager::Run, nullptr);
     // EstimatorTask.Create("Estimator", Estimator::Run, nullptr);
 
     ProducerTask.Create("ProducerDemo", ProducerDemo_Run, nullptr);
     
     Rtos::SleepMs(1000);
+    Logger::Flush();
+
+    // Print the command acknowledgements the demo produced
+    static const char* names[] = {"NOP", "ARM", "TX_ON", "TX_OFF", "DISARM"};
+    static const char* results[] = {"ACCEPTED", "REJECTED", "UNKNOWN"};
+    msg::cmd_ack ack;
+    while (acks.try_receive(ack)) {
+        const size_t type = static_cast<size_t>(ack.type), result = static_cast<size_t>(ack.result);
+        const char* typeName = type < sizeof(names) / sizeof(names[0]) ? names[type] : "?";
+        const char* resultName = result < sizeof(results) / sizeof(results[0]) ? results[result] : "?";
+        std::cout << "ACK: " << typeName << " -> " << resultName << "\n";
+    }
+
     std::cout<<"HELLO WORLD"<<std::endl;
     return 0;
 }
\ No newline at end of file
@@ -9,11 +9,35 @@ namespace msg {
     };
 
     struct cmd { 
-        enum Type{ NOP, ARM, TX_ON, TX_OFF } type; 
+        enum Type{ NOP, ARM, TX_ON, TX_OFF, DISARM, NUM_TYPES } type; 
         int32_t arg; 
         uint32_t ms; };
+
+    struct cmd_ack {
+        enum Result{ ACCEPTED, REJECTED, UNKNOWN } result;
+        cmd::Type type;
+        int32_t arg;
+        uint32_t ms; };
+
+    struct baro { float pressure_pa, temp_c; uint32_t ms; };
+
+    struct gnss{ double lat, lon; float alt; uint8_t sats; bool fix; uint32_t ms; };
+
+    struct est { float roll, pitch, yaw, climb, baro_alt; uint32_t ms; };
+
+    struct flight_event {
+        enum Type{ LAUNCH, APOGEE, LANDING } type;
+        float alt;          // m above the pad
+        uint32_t ms; };
+
+    // Downlink scheduler health, one entry per traffic class
+    struct link_stats {
+        static constexpr int NUM_CLASSES = 5;
+        uint16_t utilization_pm;                 // Link use in per mille
+        uint32_t avg_latency_us[NUM_CLASSES];
+        uint32_t max_latency_us[NUM_CLASSES];
+        uint16_t dropped[NUM_CLASSES];
+        uint32_t ms; };
 }
 
 //   struct mag { float mx, my, mz; uint32_t ms; };
-//   struct gnss{ double lat, lon; float alt; uint8_t sats; bool fix; uint32_t ms; };
-//   struct est { float roll, pitch, yaw, climb, baro_alt; uint32_t ms; };
\ No newline at end of file
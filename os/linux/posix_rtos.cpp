@@ -1,8 +1,18 @@
 #include "os/rtos.hpp"
 #include <pthread.h>
-#include <unistd.h>   // for usleep
+#include <unistd.h>   // for usleep, syscall
 #include <iostream>   // for std::cerr
-#include <semaphore.h>
+#include <atomic>
+#include <cerrno>
+#include <climits>
+#include <cstdio>
+#include <ctime>
+#include <new>
+#include <sched.h>
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <sys/mman.h>
+#include <fcntl.h>
 
 namespace Rtos {
 
@@ -11,61 +21,139 @@ void SleepMs(int ms) {
     usleep(ms * 1000);  // Convert ms to microseconds
 }
 
+uint64_t NowUs() {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return static_cast<uint64_t>(ts.tv_sec) * 1'000'000ULL + ts.tv_nsec / 1000;
+}
+
+void SleepUntilUs(uint64_t wake_us) {
+    timespec ts;
+    ts.tv_sec = static_cast<time_t>(wake_us / 1'000'000ULL);
+    ts.tv_nsec = static_cast<long>((wake_us % 1'000'000ULL) * 1000);
+    // Absolute deadline, so restarting after a signal does not stretch the sleep
+    while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, nullptr) == EINTR) {
+    }
+}
+
 // =======================
 // Task Implementation
 // =======================
 
-// Wrapper to convert function pointer to pthread-style
-struct ThreadArgs {
-    void (*fn)(void*);
-    void* arg;
-};
-
-// Static thread entry point
-void* threadEntryPoint(void* ptr) {
-    ThreadArgs* args = static_cast<ThreadArgs*>(ptr);
-    args->fn(args->arg);
-    delete args;
-    return nullptr;
-}
-
 // Platform-specific handle
 struct Task::TaskHandle {
     pthread_t thread;
     bool created = false;
     bool joined = false;
+    // Entry point, read once by the new thread before it sets started
+    void (*fn)(void*) = nullptr;
+    void* arg = nullptr;
+    char name[16] = {};  // Linux limits thread names to 15 chars
+    // Plain flag, not a semaphore: a give() still touches the semaphore
+    // after releasing the waiter, and the waiter may destroy the Task
+    std::atomic<bool> started{false};
+
+    static void* Entry(void* ptr);
 };
 
+// Static thread entry point
+void* Task::TaskHandle::Entry(void* ptr) {
+    auto* handle = static_cast<TaskHandle*>(ptr);
+    void (*fn)(void*) = handle->fn;
+    void* arg = handle->arg;
+    // Named from inside the thread so the name is set before fn runs
+    if (handle->name[0] != '\0') pthread_setname_np(pthread_self(), handle->name);
+    // Last access to the handle: the Task object may go away from here on
+    handle->started.store(true, std::memory_order_release);
+    fn(arg);
+    return nullptr;
+}
+
 // Constructor
 Task::Task() {
-    handle_ = new TaskHandle{};
+    static_assert(sizeof(TaskHandle) <= TASK_HANDLE_SIZE, "TASK_HANDLE_SIZE too small for POSIX backend");
+    static_assert(alignof(TaskHandle) <= HANDLE_ALIGN, "TaskHandle over-aligned");
+    new (storage_) TaskHandle{};
 }
 
 // Destructor
 Task::~Task() {
-    if (handle_ && !handle_->joined && handle_->created) {
-        pthread_detach(handle_->thread);  // detach if not joined
+    if (!handle()->joined && handle()->created) {
+        pthread_detach(handle()->thread);  // detach if not joined
     }
-    delete handle_;
+    handle()->~TaskHandle();
 }
 
 // Create a new thread
-void Task::Create(const char* /*name*/, void (*fn)(void*), void* arg) {
+void Task::Create(const char* name, void (*fn)(void*), void* arg) {
+    Create(name, fn, arg, TaskConfig{});
+}
 
-    auto* args = new ThreadArgs{fn, arg};
+void Task::Create(const char* name, void (*fn)(void*), void* arg, const TaskConfig& config) {
+
+    TaskHandle* h = handle();
+    h->fn = fn;
+    h->arg = arg;
+    h->started.store(false, std::memory_order_relaxed);
+    if (name) snprintf(h->name, sizeof(h->name), "%s", name);
+
+    bool realtime = config.priority > 0;
+    bool pinned = config.core >= 0;
+    int res;
+    while (true) {
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+
+        if (config.stackSize > 0) {
+            const size_t stackMin = static_cast<size_t>(PTHREAD_STACK_MIN);
+            size_t stack = config.stackSize < stackMin ? stackMin : config.stackSize;
+            pthread_attr_setstacksize(&attr, stack);
+        }
+        if (realtime) {
+            sched_param param{};
+            int lo = sched_get_priority_min(SCHED_FIFO);
+            int hi = sched_get_priority_max(SCHED_FIFO);
+            param.sched_priority = config.priority < lo ? lo : (config.priority > hi ? hi : config.priority);
+            pthread_attr_setinheritsched(&attr, PTHREAD_EXPLICIT_SCHED);
+            pthread_attr_setschedpolicy(&attr, SCHED_FIFO);
+            pthread_attr_setschedparam(&attr, &param);
+        }
+        if (pinned) {
+            cpu_set_t cpus;
+            CPU_ZERO(&cpus);
+            CPU_SET(config.core, &cpus);
+            pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+        }
+
+        res = pthread_create(&h->thread, &attr, TaskHandle::Entry, h);
+        pthread_attr_destroy(&attr);
+
+        // Fall back one feature at a time rather than not running at all
+        if (res == EPERM && realtime) {
+            std::cerr << "[Task] " << (name ? name : "?") << ": SCHED_FIFO not permitted, using default scheduling\n";
+            realtime = false;
+        } else if (res == EINVAL && pinned) {
+            std::cerr << "[Task] " << (name ? name : "?") << ": cannot pin to core " << config.core << ", running unpinned\n";
+            pinned = false;
+        } else {
+            break;
+        }
+    }
 
-    if (pthread_create(&handle_->thread, nullptr, threadEntryPoint, args) == 0) {
-        handle_->created = true;
+    if (res == 0) {
+        h->created = true;
+        // Entry point copied, no heap-held args needed. Polled, because the
+        // new thread must not touch the handle again to wake us.
+        while (!h->started.load(std::memory_order_acquire)) usleep(20);
     } else {
         std::cerr << "Failed to create task\n";
-        delete args;
     }
 }
 
 void Task::Join() {
-    if (handle_ && handle_->created && !handle_->joined) {
-        pthread_join(handle_->thread, nullptr);
-        handle_->joined = true;
+    if (handle()->created && !handle()->joined) {
+        pthread_join(handle()->thread, nullptr);
+        handle()->joined = true;
     }
 }
 
@@ -78,109 +166,137 @@ struct Mutex::MutexHandle {
 };
 
 Mutex::Mutex() {
-    handle_ = new MutexHandle;
-    if (pthread_mutex_init(&handle_->native, nullptr) != 0) {
+    static_assert(sizeof(MutexHandle) <= MUTEX_HANDLE_SIZE, "MUTEX_HANDLE_SIZE too small for POSIX backend");
+    static_assert(alignof(MutexHandle) <= HANDLE_ALIGN, "MutexHandle over-aligned");
+    new (storage_) MutexHandle;
+    if (pthread_mutex_init(&handle()->native, nullptr) != 0) {
         std::cerr << "Mutex init failed\n";
     }
 }
 
 Mutex::~Mutex() {
-    pthread_mutex_destroy(&handle_->native);
-    delete handle_;
+    pthread_mutex_destroy(&handle()->native);
+    handle()->~MutexHandle();
 }
 
 void Mutex::lock() {
-    pthread_mutex_lock(&handle_->native);
+    pthread_mutex_lock(&handle()->native);
 }
 
 void Mutex::unlock() {
-    pthread_mutex_unlock(&handle_->native);
+    pthread_mutex_unlock(&handle()->native);
 }
 
 // =======================
-// Binary Semaphore Implementation
+// Futex helpers
 // =======================
+//
+// Both semaphores keep their count in a 32-bit atomic. take/give only go
+// through an atomic fast path; the futex syscall is made only when a task
+// must sleep (count is zero) or when a sleeper must be woken. Timeouts are
+// absolute CLOCK_MONOTONIC deadlines (FUTEX_WAIT_BITSET), so they neither
+// stretch across EINTR restarts nor jump when the wall clock is stepped.
+
+namespace {
+
+// Absolute CLOCK_MONOTONIC deadline timeout_ms from now
+timespec MonotonicDeadline(int timeout_ms) {
+    timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    ts.tv_sec += timeout_ms / 1000;
+    ts.tv_nsec += (timeout_ms % 1000) * 1'000'000L;
 
-struct BinarySemaphore::SemaphoreHandle {
-    pthread_mutex_t mutex;
-    pthread_cond_t cond;
-    bool available;  // acts like a binary flag
-};
+    // Normalize nanoseconds
+    if (ts.tv_nsec >= 1'000'000'000) {
+        ts.tv_sec += ts.tv_nsec / 1'000'000'000;
+        ts.tv_nsec %= 1'000'000'000;
+    }
+    return ts;
+}
 
-BinarySemaphore::BinarySemaphore() {
-    handle_ = new SemaphoreHandle;
-    pthread_mutex_init(&handle_->mutex, nullptr);
-    pthread_cond_init(&handle_->cond, nullptr);
-    handle_->available = false;  // starts as "not given"
+// Sleeps while *word == expected. Returns false only on timeout.
+bool FutexWait(std::atomic<uint32_t>* word, uint32_t expected, const timespec* deadline) {
+    long res = syscall(SYS_futex, reinterpret_cast<uint32_t*>(word),
+                       FUTEX_WAIT_BITSET_PRIVATE, expected, deadline,
+                       nullptr, FUTEX_BITSET_MATCH_ANY);
+    return !(res == -1 && errno == ETIMEDOUT);  // EAGAIN/EINTR: caller retries
 }
 
-BinarySemaphore::~BinarySemaphore() {
-    pthread_cond_destroy(&handle_->cond);
-    pthread_mutex_destroy(&handle_->mutex);
-    delete handle_;
+void FutexWake(std::atomic<uint32_t>* word, uint32_t count) {
+    syscall(SYS_futex, reinterpret_cast<uint32_t*>(word),
+            FUTEX_WAKE_PRIVATE, count, nullptr, nullptr, 0);
 }
 
-bool BinarySemaphore::take(int timeout_ms) {
-    if(timeout_ms<0){
-        pthread_mutex_lock(&handle_->mutex);
-        while (!handle_->available) {
-            pthread_cond_wait(&handle_->cond, &handle_->mutex);
+// Decrements count if non-zero
+bool TryDecrement(std::atomic<uint32_t>& count) {
+    uint32_t value = count.load(std::memory_order_relaxed);
+    while (value > 0) {
+        if (count.compare_exchange_weak(value, value - 1, std::memory_order_acquire,
+                                        std::memory_order_relaxed)) {
+            return true;
         }
-        handle_->available = false;  // consume the semaphore
-        pthread_mutex_unlock(&handle_->mutex);
-        return true;
     }
+    return false;
+}
 
-    struct timespec ts;
-    clock_gettime(CLOCK_REALTIME, &ts);
-    ts.tv_sec += timeout_ms / 1000;
-    ts.tv_nsec += (timeout_ms % 1000) * 1'000'000;
-
-    // Normalize nanoseconds
-    if (ts.tv_nsec >= 1'000'000'000) {
-        ts.tv_sec += ts.tv_nsec / 1'000'000'000;
-        ts.tv_nsec %= 1'000'000'000;
-    }
+// Slow path shared by both semaphores: register as a waiter and sleep on
+// the count word until a decrement succeeds or the deadline passes.
+bool WaitDecrement(std::atomic<uint32_t>& count, std::atomic<uint32_t>& waiters, int timeout_ms) {
+    timespec deadline;
+    if (timeout_ms >= 0) deadline = MonotonicDeadline(timeout_ms);
 
+    waiters.fetch_add(1, std::memory_order_seq_cst);
     bool acquired = false;
-
-    pthread_mutex_lock(&handle_->mutex);
-    while (!handle_->available) {
-        int res = pthread_cond_timedwait(&handle_->cond, &handle_->mutex, &ts);
-        if (res == ETIMEDOUT) {
-            acquired = false;
+    while (true) {
+        if (TryDecrement(count)) {
+            acquired = true;
             break;
         }
-        if (res != 0) {
-            std::cerr << "[BinarySemaphore] pthread_cond_timedwait failed\n";
-            acquired = false;
+        if (!FutexWait(&count, 0, timeout_ms >= 0 ? &deadline : nullptr)) {
+            acquired = TryDecrement(count);  // Last look after timing out
             break;
         }
     }
-    if (handle_->available) {
-        handle_->available = false;
-        acquired = true;
-    }
-    pthread_mutex_unlock(&handle_->mutex);
+    waiters.fetch_sub(1, std::memory_order_relaxed);
     return acquired;
 }
 
+} // namespace
+
+// =======================
+// Binary Semaphore Implementation
+// =======================
+
+struct BinarySemaphore::SemaphoreHandle {
+    std::atomic<uint32_t> available{0};  // acts like a binary flag
+    std::atomic<uint32_t> waiters{0};
+};
+
+BinarySemaphore::BinarySemaphore() {
+    static_assert(sizeof(SemaphoreHandle) <= SEMAPHORE_HANDLE_SIZE, "SEMAPHORE_HANDLE_SIZE too small for POSIX backend");
+    static_assert(alignof(SemaphoreHandle) <= HANDLE_ALIGN, "SemaphoreHandle over-aligned");
+    new (storage_) SemaphoreHandle;  // starts as "not given"
+}
+
+BinarySemaphore::~BinarySemaphore() {
+    handle()->~SemaphoreHandle();
+}
+
+bool BinarySemaphore::take(int timeout_ms) {
+    if (TryDecrement(handle()->available)) return true;
+    if (timeout_ms == 0) return false;
+    return WaitDecrement(handle()->available, handle()->waiters, timeout_ms);
+}
+
 bool BinarySemaphore::try_take() {
-    bool acquired = false;
-    pthread_mutex_lock(&handle_->mutex);
-    if (handle_->available) {
-        handle_->available = false;
-        acquired = true;
-    }
-    pthread_mutex_unlock(&handle_->mutex);
-    return acquired;
+    return TryDecrement(handle()->available);
 }
 
 void BinarySemaphore::give() {
-    pthread_mutex_lock(&handle_->mutex);
-    handle_->available = true;
-    pthread_cond_signal(&handle_->cond);  // wake one waiting thread
-    pthread_mutex_unlock(&handle_->mutex);
+    handle()->available.store(1, std::memory_order_seq_cst);
+    if (handle()->waiters.load(std::memory_order_seq_cst) > 0) {
+        FutexWake(&handle()->available, 1);  // wake one waiting thread
+    }
 }
 
 // =======================
@@ -188,72 +304,214 @@ void BinarySemaphore::give() {
 // =======================
 
 struct CountingSemaphore::CountingSemHandle {
-    sem_t sem;
-    unsigned maxCount;
+    std::atomic<uint32_t> count{0};
+    std::atomic<uint32_t> waiters{0};
+    uint32_t maxCount;
 };
 
 CountingSemaphore::CountingSemaphore(size_t maxCount, size_t initialCount) {
-    handle_ = new CountingSemHandle;
-    handle_->maxCount = static_cast<unsigned>(maxCount);
+    static_assert(sizeof(CountingSemHandle) <= COUNTING_SEM_HANDLE_SIZE, "COUNTING_SEM_HANDLE_SIZE too small for POSIX backend");
+    static_assert(alignof(CountingSemHandle) <= HANDLE_ALIGN, "CountingSemHandle over-aligned");
+    new (storage_) CountingSemHandle;
+
+    if (maxCount > UINT32_MAX) maxCount = UINT32_MAX;
+    handle()->maxCount = static_cast<uint32_t>(maxCount);
 
     if (initialCount > maxCount) {
         std::cerr << "[CountingSemaphore] Error: Initial count > max count\n";
         initialCount = maxCount;  // clamp
     }
-
-    if (sem_init(&handle_->sem, 0, static_cast<unsigned>(initialCount)) != 0) {
-        std::cerr << "[CountingSemaphore] sem_init failed\n";
-    }
+    handle()->count.store(static_cast<uint32_t>(initialCount), std::memory_order_relaxed);
 }
 
 CountingSemaphore::~CountingSemaphore() {
-    sem_destroy(&handle_->sem);
-    delete handle_;
+    handle()->~CountingSemHandle();
 }
 
 bool CountingSemaphore::take(int timeout_ms) {
-    if(timeout_ms<0){
-        while (sem_wait(&handle_->sem) != 0) {
-            if (errno != EINTR) {
-                std::cerr << "[CountingSemaphore] sem_wait failed\n";
-                return false;
-            }
+    if (TryDecrement(handle()->count)) return true;
+    if (timeout_ms == 0) return false;
+    return WaitDecrement(handle()->count, handle()->waiters, timeout_ms);
+}
+
+bool CountingSemaphore::try_take() {
+    return TryDecrement(handle()->count);
+}
+
+void CountingSemaphore::give() {
+    give_n(1);
+}
+
+size_t CountingSemaphore::try_take_n(size_t max) {
+    uint32_t value = handle()->count.load(std::memory_order_relaxed);
+    while (value > 0 && max > 0) {
+        uint32_t taken = value < max ? value : static_cast<uint32_t>(max);
+        if (handle()->count.compare_exchange_weak(value, value - taken, std::memory_order_acquire,
+                                                 std::memory_order_relaxed)) {
+            return taken;
         }
-        return true;
     }
-    struct timespec ts;
-    clock_gettime(CLOCK_REALTIME, &ts);
-    ts.tv_sec += timeout_ms / 1000;
-    ts.tv_nsec += (timeout_ms % 1000) * 1'000'000;
+    return 0;
+}
 
-    // Normalize nanoseconds
-    if (ts.tv_nsec >= 1'000'000'000) {
-        ts.tv_sec += ts.tv_nsec / 1'000'000'000;
-        ts.tv_nsec %= 1'000'000'000;
+void CountingSemaphore::give_n(size_t n) {
+    uint32_t value = handle()->count.load(std::memory_order_relaxed);
+    uint32_t added;
+    do {
+        uint32_t room = handle()->maxCount - value;
+        added = n < room ? static_cast<uint32_t>(n) : room;
+    } while (added > 0 &&
+             !handle()->count.compare_exchange_weak(value, value + added, std::memory_order_seq_cst,
+                                                   std::memory_order_relaxed));
+
+    if (added < n) {
+        std::cerr << "[CountingSemaphore] give() called when full\n";
+    }
+    if (added > 0 && handle()->waiters.load(std::memory_order_seq_cst) > 0) {
+        FutexWake(&handle()->count, added);  // wake up to one waiter per count
+    }
+}
+
+// =======================
+// Event Group Implementation
+// =======================
+
+struct EventGroup::EventGroupHandle {
+    std::atomic<uint32_t> bits{0};     // Also the futex word
+    std::atomic<uint32_t> waiters{0};
+};
+
+EventGroup::EventGroup() {
+    static_assert(sizeof(EventGroupHandle) <= EVENT_GROUP_HANDLE_SIZE, "EVENT_GROUP_HANDLE_SIZE too small for POSIX backend");
+    static_assert(alignof(EventGroupHandle) <= HANDLE_ALIGN, "EventGroupHandle over-aligned");
+    new (storage_) EventGroupHandle;
+}
+
+EventGroup::~EventGroup() {
+    handle()->~EventGroupHandle();
+}
+
+uint32_t EventGroup::set(uint32_t bits) {
+    bits &= ALL_BITS;
+    const uint32_t old = handle()->bits.fetch_or(bits, std::memory_order_seq_cst);
+    // Waiters sleep on the exact value they saw, so only a change can matter
+    if ((old | bits) != old && handle()->waiters.load(std::memory_order_seq_cst) > 0) {
+        FutexWake(&handle()->bits, INT_MAX);  // Every waiter re-checks its own condition
     }
+    return old | bits;
+}
+
+uint32_t EventGroup::clear(uint32_t bits) {
+    return handle()->bits.fetch_and(~bits, std::memory_order_seq_cst);
+}
+
+uint32_t EventGroup::get() {
+    return handle()->bits.load(std::memory_order_acquire);
+}
 
-    while(sem_timedwait(&handle_->sem, &ts)!=0){
-        if(errno == ETIMEDOUT) return false;
-        if (errno != EINTR) {
-            std::cerr << "[CountingSemaphore] sem_wait failed\n";
-            return false;
+uint32_t EventGroup::wait(uint32_t bits, bool waitAll, bool clearOnExit, int timeout_ms) {
+    bits &= ALL_BITS;
+    auto satisfied = [&](uint32_t v) { return waitAll ? (v & bits) == bits : (v & bits) != 0; };
+    // Claims the flags: with clearOnExit the check and the clear are one CAS
+    auto tryClaim = [&](uint32_t& v) {
+        v = handle()->bits.load(std::memory_order_acquire);
+        while (satisfied(v)) {
+            if (!clearOnExit) return true;
+            if (handle()->bits.compare_exchange_weak(v, v & ~bits, std::memory_order_acq_rel,
+                                                     std::memory_order_acquire)) {
+                return true;
+            }
+        }
+        return false;
+    };
+
+    uint32_t value;
+    if (tryClaim(value) || timeout_ms == 0) return value;
+
+    timespec deadline;
+    if (timeout_ms >= 0) deadline = MonotonicDeadline(timeout_ms);
+
+    handle()->waiters.fetch_add(1, std::memory_order_seq_cst);
+    while (!tryClaim(value)) {
+        if (!FutexWait(&handle()->bits, value, timeout_ms >= 0 ? &deadline : nullptr)) {
+            tryClaim(value);  // Last look after timing out
+            break;
         }
     }
-    return true;
+    handle()->waiters.fetch_sub(1, std::memory_order_relaxed);
+    return value;
 }
+// =======================
+// Persistent Region Implementation
+// =======================
 
-bool CountingSemaphore::try_take() {
-    return (sem_trywait(&handle_->sem) == 0);
+struct PersistentRegion::RegionHandle {
+    int fd = -1;
+    uint8_t* data = nullptr;
+    size_t size = 0;
+};
+
+PersistentRegion::PersistentRegion() {
+    static_assert(sizeof(RegionHandle) <= REGION_HANDLE_SIZE, "REGION_HANDLE_SIZE too small for POSIX backend");
+    static_assert(alignof(RegionHandle) <= HANDLE_ALIGN, "RegionHandle over-aligned");
+    new (storage_) RegionHandle;
 }
 
-void CountingSemaphore::give() {
-    int val;
-    sem_getvalue(&handle_->sem, &val);
+PersistentRegion::~PersistentRegion() {
+    close();
+    handle()->~RegionHandle();
+}
 
-    if (static_cast<unsigned>(val) < handle_->maxCount) {
-        sem_post(&handle_->sem);
-    } else {
-        std::cerr << "[CountingSemaphore] give() called when full\n";
+bool PersistentRegion::open(const char* name, size_t size) {
+    close();
+    const int fd = ::open(name, O_RDWR | O_CREAT | O_CLOEXEC, 0644);
+    if (fd < 0) {
+        std::cerr << "[PersistentRegion] cannot open " << name << "\n";
+        return false;
     }
+    // Reserve the blocks now: a store into a sparse page on a full disk
+    // would be a SIGBUS in the middle of a flight
+    if (posix_fallocate(fd, 0, static_cast<off_t>(size)) != 0) {
+        std::cerr << "[PersistentRegion] cannot allocate " << size << " bytes for " << name << "\n";
+        ::close(fd);
+        return false;
+    }
+    void* data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+        std::cerr << "[PersistentRegion] cannot map " << name << "\n";
+        ::close(fd);
+        return false;
+    }
+    handle()->fd = fd;
+    handle()->data = static_cast<uint8_t*>(data);
+    handle()->size = size;
+    return true;
+}
+
+void PersistentRegion::close() {
+    RegionHandle* h = handle();
+    if (h->data) munmap(h->data, h->size);
+    if (h->fd >= 0) ::close(h->fd);
+    *h = RegionHandle{};
+}
+
+uint8_t* PersistentRegion::data() {
+    return handle()->data;
+}
+
+size_t PersistentRegion::size() {
+    return handle()->size;
+}
+
+bool PersistentRegion::sync(size_t offset, size_t len) {
+    RegionHandle* h = handle();
+    if (!h->data || offset > h->size) return false;
+    if (len > h->size - offset) len = h->size - offset;
+    if (len == 0) return true;
+    // msync wants a page-aligned start
+    static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    const size_t start = offset & ~(page - 1);
+    return msync(h->data + start, offset + len - start, MS_SYNC) == 0;
 }
+
 }  // namespace Rtos
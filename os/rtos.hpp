@@ -1,25 +1,214 @@
 #pragma once
 #include <cstddef> // Required for size_t
+#include <cstdint>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <type_traits>
+#include <new>      // std::launder
 
 namespace Rtos {
 
 constexpr int MAX_TIMEOUT = -1; // Infinite block
+constexpr size_t CACHE_LINE_SIZE = 64; // Used to keep hot atomics apart
+
+//== Backend handle storage ==//
+// Every OSAL object keeps its platform handle inline in aligned storage
+// instead of new-ing it, so the OSAL never touches the heap, static
+// construction of global queues is deterministic, and a primitive sits in
+// the same cache lines as the object that embeds it. The sizes are upper
+// bounds per backend; each backend static_asserts that its handles fit.
+#if defined(RTOS_PLATFORM_STM32)
+// FreeRTOS static control blocks (StaticTask_t, StaticSemaphore_t) on 32-bit
+constexpr size_t TASK_HANDLE_SIZE = 160;
+constexpr size_t MUTEX_HANDLE_SIZE = 96;
+constexpr size_t SEMAPHORE_HANDLE_SIZE = 96;
+constexpr size_t COUNTING_SEM_HANDLE_SIZE = 96;
+constexpr size_t EVENT_GROUP_HANDLE_SIZE = 64;
+constexpr size_t REGION_HANDLE_SIZE = 32;     // Flash partition bounds + staging state
+#elif defined(RTOS_PLATFORM_LINUX) || defined(__linux__)
+// pthread_t + entry point, pthread_mutex_t, futex words
+constexpr size_t TASK_HANDLE_SIZE = 64;
+constexpr size_t MUTEX_HANDLE_SIZE = 64;
+constexpr size_t SEMAPHORE_HANDLE_SIZE = 16;
+constexpr size_t COUNTING_SEM_HANDLE_SIZE = 16;
+constexpr size_t EVENT_GROUP_HANDLE_SIZE = 16;
+constexpr size_t REGION_HANDLE_SIZE = 32;     // fd, mapping, size
+#else
+#error "Unknown RTOS platform: define RTOS_PLATFORM_LINUX or RTOS_PLATFORM_STM32"
+#endif
+constexpr size_t HANDLE_ALIGN = alignof(std::max_align_t);
 
 void SleepMs(int ms);
 
+uint64_t NowUs();                   // Monotonic time in microseconds
+void SleepUntilUs(uint64_t wake_us); // Absolute-deadline sleep on the NowUs() clock
+
 //== Task abstraction ==//
 // This class provides a simple task wrapper
+
+// Optional scheduling parameters for Task::Create
+//
+// On Linux a non-zero priority selects SCHED_FIFO (1..99, higher runs
+// first) and core pins the task with pthread_setaffinity_np. On FreeRTOS
+// priority maps to the task priority and stackSize to the stack depth.
+// If the process is not allowed real-time scheduling or the core does not
+// exist, the task is still created with default scheduling and a warning.
+struct TaskConfig {
+    int priority = 0;       // 0: default (time-shared) scheduling
+    size_t stackSize = 0;   // Bytes, 0: platform default
+    int core = -1;          // CPU to pin to, -1: run anywhere
+};
+
 class Task {
 public:
     Task();
     ~Task();
 
     void Create(const char* name, void (*fn)(void*), void* arg);
+    void Create(const char* name, void (*fn)(void*), void* arg, const TaskConfig& config);
     void Join();
 
+    Task(const Task&) = delete;
+    Task& operator=(const Task&) = delete;
+
 private:
     struct TaskHandle;
-    TaskHandle* handle_;
+    TaskHandle* handle() { return std::launder(reinterpret_cast<TaskHandle*>(storage_)); }
+    alignas(HANDLE_ALIGN) unsigned char storage_[TASK_HANDLE_SIZE];
+};
+
+//== Periodic task abstraction ==//
+// Runs fn(arg) every period_us on its own task.
+//
+// Releases are absolute deadlines (start + k * period) rather than a
+// relative sleep after each job, so the loop period does not drift with
+// the job's run time and jitter does not accumulate. Maps to
+// clock_nanosleep(TIMER_ABSTIME) on Linux and vTaskDelayUntil on FreeRTOS.
+//
+// If a job runs past its next release, the missed releases are skipped
+// (keeping the original phase) and counted in overruns().
+class PeriodicTask {
+public:
+    PeriodicTask() = default;
+
+    // false (and no task) for a zero period
+    bool Create(const char* name, uint32_t period_us, void (*fn)(void*), void* arg,
+                const TaskConfig& config = TaskConfig{}) {
+        if (period_us == 0) return false;
+        fn_ = fn;
+        arg_ = arg;
+        period_us_ = period_us;
+        running_.store(true, std::memory_order_relaxed);
+        task_.Create(name, Loop, this, config);
+        return true;
+    }
+
+    void Stop() { running_.store(false, std::memory_order_relaxed); } // Exits after the current job
+    void Join() { task_.Join(); }
+
+    uint32_t period_us() const { return period_us_; }
+    uint64_t cycles() const { return cycles_.load(std::memory_order_relaxed); }     // Jobs run
+    uint64_t overruns() const { return overruns_.load(std::memory_order_relaxed); } // Releases missed
+    // Index k of the release start + k * period the running job belongs to
+    // (from within the job; elsewhere, the next one). Skipped releases count.
+    uint64_t release() const { return cycles() + overruns(); }
+
+private:
+    static void Loop(void* self) {
+        auto* t = static_cast<PeriodicTask*>(self);
+        uint64_t next = NowUs();
+        while (t->running_.load(std::memory_order_relaxed)) {
+            t->fn_(t->arg_);
+            t->cycles_.fetch_add(1, std::memory_order_relaxed);
+
+            next += t->period_us_;
+            uint64_t now = NowUs();
+            if (now >= next) {
+                // Overran into the next period(s): skip them, keep the phase
+                uint64_t missed = (now - next) / t->period_us_ + 1;
+                t->overruns_.fetch_add(missed, std::memory_order_relaxed);
+                next += missed * t->period_us_;
+            }
+            SleepUntilUs(next);
+        }
+    }
+
+    Task task_;
+    void (*fn_)(void*) = nullptr;
+    void* arg_ = nullptr;
+    uint32_t period_us_ = 0;
+    std::atomic<bool> running_{false};
+    std::atomic<uint64_t> cycles_{0};
+    std::atomic<uint64_t> overruns_{0};
+};
+
+//== Rate group ==//
+// Harmonic rate group: several step functions driven by one PeriodicTask.
+//
+// Each member runs every `divider` base ticks, so a 1 kHz base with
+// dividers 1, 10 and 100 gives 1 kHz, 100 Hz and 10 Hz loops that stay
+// phase-locked and cost one task. Members run in the order they were added
+// within a tick; a slow member delays the others and shows up as an
+// overrun on the driving PeriodicTask.
+//
+// Ticks are counted in base releases, not in jobs run, so the slower
+// members keep their wall-clock rate across overruns: a member whose
+// release was skipped runs once on the next tick instead (several skipped
+// releases of one member, an overrun of divider or more base periods,
+// collapse into that one run).
+//
+//   Rtos::RateGroup group;
+//   Rtos::PeriodicTask baseTask;
+//   group.Add(EstimatorStep, nullptr, 1);
+//   group.Add(StateMachineStep, nullptr, 10);
+//   group.Add(TelemetryStep, nullptr, 100);
+//   group.Start(baseTask, "RateGroup", 1000);
+//
+class RateGroup {
+public:
+    static constexpr size_t MAX_MEMBERS = 8;
+
+    // Must be called before the driving task is created
+    bool Add(void (*fn)(void*), void* arg, uint32_t divider) {
+        if (count_ >= MAX_MEMBERS || divider == 0) return false;
+        members_[count_++] = Member{fn, arg, divider};
+        return true;
+    }
+
+    // Drives the group from base at base_period_us. false for a zero period
+    bool Start(PeriodicTask& base, const char* name, uint32_t base_period_us,
+               const TaskConfig& config = TaskConfig{}) {
+        base_ = &base;
+        return base.Create(name, base_period_us, Tick, this, config);
+    }
+
+private:
+    // PeriodicTask entry point, arg is the RateGroup
+    static void Tick(void* self) {
+        auto* g = static_cast<RateGroup*>(self);
+        const uint64_t tick = g->base_->release();
+        for (size_t i = 0; i < g->count_; ++i) {
+            const Member& m = g->members_[i];
+            // Due if one of its releases came up since the last tick
+            if (!g->started_ || tick / m.divider != g->lastTick_ / m.divider) m.fn(m.arg);
+        }
+        g->lastTick_ = tick;
+        g->started_ = true;
+    }
+
+    struct Member {
+        void (*fn)(void*);
+        void* arg;
+        uint32_t divider;
+    };
+
+    Member members_[MAX_MEMBERS] = {};
+    size_t count_ = 0;
+    const PeriodicTask* base_ = nullptr;
+    uint64_t lastTick_ = 0;   // Base release of the previous tick
+    bool started_ = false;
 };
 
 //== Mutex abstraction ==//
@@ -33,9 +222,13 @@ public:
     void lock();
     void unlock();
 
+    Mutex(const Mutex&) = delete;
+    Mutex& operator=(const Mutex&) = delete;
+
 private:
     struct MutexHandle;
-    MutexHandle* handle_;
+    MutexHandle* handle() { return std::launder(reinterpret_cast<MutexHandle*>(storage_)); }
+    alignas(HANDLE_ALIGN) unsigned char storage_[MUTEX_HANDLE_SIZE];
 };
 
 //== Binary Semaphore abstraction ==//
@@ -48,9 +241,13 @@ public:
     bool try_take();        // Non-blocking
     void give();            // Releases the semaphore
 
+    BinarySemaphore(const BinarySemaphore&) = delete;
+    BinarySemaphore& operator=(const BinarySemaphore&) = delete;
+
 private:
     struct SemaphoreHandle;
-    SemaphoreHandle* handle_;
+    SemaphoreHandle* handle() { return std::launder(reinterpret_cast<SemaphoreHandle*>(storage_)); }
+    alignas(HANDLE_ALIGN) unsigned char storage_[SEMAPHORE_HANDLE_SIZE];
 };
 
 
@@ -68,9 +265,114 @@ public:
     bool try_take();  // non‐blocking: if count>0 then --count, else false
     void give();      // ++count, wake one waiter if present
 
+    // Batch variants used by the queue send_n/receive_n paths
+    size_t try_take_n(size_t max);  // non-blocking: takes up to max, returns how many
+    void give_n(size_t n);          // count += n, wake up to n waiters
+
+    CountingSemaphore(const CountingSemaphore&) = delete;
+    CountingSemaphore& operator=(const CountingSemaphore&) = delete;
+
 private:
     struct CountingSemHandle;
-    CountingSemHandle* handle_;
+    CountingSemHandle* handle() { return std::launder(reinterpret_cast<CountingSemHandle*>(storage_)); }
+    alignas(HANDLE_ALIGN) unsigned char storage_[COUNTING_SEM_HANDLE_SIZE];
+};
+
+//== Event group abstraction ==//
+// A word of event flags that tasks set and wait on, mirroring FreeRTOS
+// event groups (24 usable bits, as there). On Linux the flags are the
+// futex word itself: set is one fetch_or, plus a wake-all only when the
+// value changed and somebody is asleep.
+class EventGroup {
+public:
+    static constexpr uint32_t ALL_BITS = 0x00FFFFFF;
+
+    EventGroup();
+    ~EventGroup();
+
+    uint32_t set(uint32_t bits);     // Returns the flags after setting, wakes waiters
+    uint32_t clear(uint32_t bits);   // Returns the flags before clearing
+    uint32_t get();
+
+    // Blocks until any (or, with waitAll, every) flag in bits is set and
+    // returns the flags as they were at that moment; clearOnExit clears
+    // the waited-for bits atomically with the wake-up. On timeout the
+    // returned flags simply do not satisfy the condition.
+    uint32_t wait(uint32_t bits, bool waitAll = false, bool clearOnExit = true, int timeout_ms = -1);
+
+    EventGroup(const EventGroup&) = delete;
+    EventGroup& operator=(const EventGroup&) = delete;
+
+private:
+    struct EventGroupHandle;
+    EventGroupHandle* handle() { return std::launder(reinterpret_cast<EventGroupHandle*>(storage_)); }
+    alignas(HANDLE_ALIGN) unsigned char storage_[EVENT_GROUP_HANDLE_SIZE];
+};
+
+// Link from a queue to the set it belongs to. Sends call notify(), which
+// is one acquire load while the queue is in no set.
+class SetLink {
+public:
+    void attach(EventGroup* group, uint32_t bits) {
+        bits_ = bits;
+        group_.store(group, std::memory_order_release);
+    }
+
+    void notify() {
+        if (EventGroup* g = group_.load(std::memory_order_acquire)) g->set(bits_);
+    }
+
+private:
+    std::atomic<EventGroup*> group_{nullptr};
+    uint32_t bits_ = 0;
+};
+
+//== Queue set abstraction ==//
+// Lets one task block on several queues (and other event sources) at once,
+// like FreeRTOS queue sets. Every member owns a bit; a successful send on
+// a member sets it. wait() returns the bits of the members that may hold
+// data and clears them, so the task drains each of those with try_receive
+// until it is empty, then waits again. A send that races with the drain
+// only costs a spurious wake-up, never a lost one.
+//
+// Any queue with attach_set() can be a member: Queue, SpscQueue,
+// MpmcQueue and Bus subscribers. add_signal() reserves a bit without a
+// queue behind it, for sources such as timers that call signal().
+// A queue belongs to at most one set, and the set must outlive it.
+class QueueSet {
+public:
+    static constexpr int MAX_MEMBERS = 24;
+
+    // Returns the member's bit, or 0 if the set is full or q cannot join
+    template <typename Q>
+    uint32_t add(Q& q) {
+        if (count_ >= MAX_MEMBERS) return 0;
+        const uint32_t bit = 1u << count_;
+        if (!q.attach_set(&events_, bit)) return 0;
+        count_++;
+        members_ |= bit;
+        events_.set(bit);   // It may already hold data: drain it once
+        return bit;
+    }
+
+    uint32_t add_signal() {
+        if (count_ >= MAX_MEMBERS) return 0;
+        const uint32_t bit = 1u << count_++;
+        members_ |= bit;
+        return bit;
+    }
+
+    void signal(uint32_t bits) { events_.set(bits & members_); }
+
+    // Ready member bits, 0 on timeout
+    uint32_t wait(int timeout_ms = MAX_TIMEOUT) {
+        return events_.wait(members_, false, true, timeout_ms) & members_;
+    }
+
+private:
+    EventGroup events_;
+    uint32_t members_ = 0;
+    int count_ = 0;
 };
 
 //== Queue abstraction ==//
@@ -113,8 +415,9 @@ public:
             if(!spaceAvailable.try_take()){
                 isFull = true; // Queue is full, will overwrite
                 lock.lock();
-                tail = (tail + 1) % Capacity; // Overwrite oldest item
+                bool dropped = dropOldest();
                 lock.unlock();
+                if(!dropped) return false;
             }
         }
         
@@ -123,9 +426,8 @@ public:
         head = (head + 1) % Capacity;
         wasOverwritten = isFull; // Track if last item was overwritten
         lock.unlock();
-        if(!isFull) {
-            dataAvailable.give(); // Signal data is available
-        }
+        dataAvailable.give(); // Signal data is available
+        set_.notify();
         return true;
     }
 
@@ -139,8 +441,9 @@ public:
             if(!spaceAvailable.try_take()){
                 isFull = true; // Queue is full, will overwrite
                 lock.lock();
-                tail = (tail + 1) % Capacity; // Overwrite oldest item
+                bool dropped = dropOldest();
                 lock.unlock();
+                if(!dropped) return false;
             }
         }
 
@@ -150,9 +453,8 @@ public:
         wasOverwritten = isFull; // Track if last item was overwritten
         lock.unlock();
 
-        if(!isFull) {
-            dataAvailable.give(); // Signal data is available
-        }
+        dataAvailable.give(); // Signal data is available
+        set_.notify();
         return true;
     }
 
@@ -178,11 +480,205 @@ public:
         return true;
     }
 
+    //-- Batch operations --//
+    // Move a run of items under a single lock round-trip and one
+    // semaphore update per side, instead of one of each per item.
+
+    // Sends items[0..n), blocking up to timeout_ms for space.
+    // In overwrite mode never blocks and drops the oldest items as needed.
+    // Returns the number of items sent (n unless the timeout expired).
+    size_t send_n(const T* items, size_t n, int timeout_ms = -1) {
+        if (n == 0) return 0;
+
+        if (overwrite_) {
+            const size_t requested = n;
+            if (n > Capacity) {
+                // Only the newest Capacity items can survive anyway
+                items += n - Capacity;
+                n = Capacity;
+            }
+            size_t space = spaceAvailable.try_take_n(n);
+            size_t dropped = 0;
+            bool limited = false;
+            lock.lock();
+            if (space < n && !readLoan_) {
+                // Claim the oldest items' data tokens before dropping them
+                dropped = dataAvailable.try_take_n(n - space);
+            }
+            if (space + dropped < n) {
+                // Oldest item is on loan or being received, only fill what we freed
+                items += n - (space + dropped);
+                n = space + dropped;
+                limited = true;
+            }
+            tail = (tail + dropped) % Capacity; // Overwrite oldest items
+            copyIn(items, n);
+            wasOverwritten = !limited && (requested > n || dropped > 0);
+            lock.unlock();
+            dataAvailable.give_n(n);
+            set_.notify();
+            return limited ? n : requested;
+        }
+
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::milliseconds(timeout_ms);
+        size_t sent = 0;
+        while (sent < n) {
+            int wait_ms = timeout_ms;
+            if (timeout_ms > 0 && sent > 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                wait_ms = left > 0 ? static_cast<int>(left) : 0;
+            }
+            bool gotSpace = wait_ms == 0 ? spaceAvailable.try_take()
+                                         : spaceAvailable.take(wait_ms);
+            if (!gotSpace) break;
+            size_t run = 1 + spaceAvailable.try_take_n(n - sent - 1);
+
+            lock.lock();
+            copyIn(items + sent, run);
+            wasOverwritten = false;
+            lock.unlock();
+            dataAvailable.give_n(run);
+            set_.notify();
+            sent += run;
+        }
+        return sent;
+    }
+
+    // Receives up to max items into items[], blocking up to timeout_ms
+    // for the first one. Returns the number received (0 on timeout).
+    size_t receive_n(T* items, size_t max, int timeout_ms = -1) {
+        if (max == 0) return 0;
+        bool gotData = timeout_ms == 0 ? dataAvailable.try_take()
+                                       : dataAvailable.take(timeout_ms);
+        if (!gotData) return 0;
+        size_t run = 1 + dataAvailable.try_take_n(max - 1);
+
+        lock.lock();
+        copyOut(items, run);
+        lock.unlock();
+        spaceAvailable.give_n(run);
+        return run;
+    }
+
+    // Calls fn(const T&) on every pending item in order and removes them,
+    // waiting up to timeout_ms (default: don't wait) if the queue is empty.
+    // Items are processed in place while the queue lock is held, so keep
+    // fn short. Returns the number of items drained.
+    template <typename Fn>
+    size_t drain(Fn fn, int timeout_ms = 0) {
+        bool gotData = timeout_ms == 0 ? dataAvailable.try_take()
+                                       : dataAvailable.take(timeout_ms);
+        if (!gotData) return 0;
+        size_t run = 1 + dataAvailable.try_take_n(Capacity - 1);
+
+        lock.lock();
+        for (size_t i = 0; i < run; ++i) {
+            fn(static_cast<const T&>(buffer[tail]));
+            tail = (tail + 1) % Capacity;
+        }
+        lock.unlock();
+        spaceAvailable.give_n(run);
+        return run;
+    }
+
+    //-- Zero-copy loans --//
+    // For large payloads (image frames, telemetry packets) the producer
+    // builds the message directly in the ring slot and the consumer reads
+    // it in place, so nothing is copied on either side.
+    //
+    //   T* slot = q.acquire_slot();          const T* m = q.peek_front();
+    //   ... fill *slot ...                   ... use *m ...
+    //   q.commit();                          q.release();
+    //
+    // Each side may hold at most one loan at a time, and while a side has
+    // a loan outstanding no other task may send (resp. receive) on this
+    // queue. In overwrite mode a full queue drops its oldest item for the
+    // new slot, unless that item is currently on loan to the consumer, in
+    // which case the send fails instead. The dropped item's data token goes
+    // with it, so the slot on loan is never visible to receivers.
+
+    // Loans the next free slot, waiting up to timeout_ms for space.
+    // Returns nullptr on timeout or if a write loan is already outstanding.
+    T* acquire_slot(int timeout_ms = -1) {
+        bool isFull = false;
+        if(!overwrite_){
+            if(!spaceAvailable.take(timeout_ms)) return nullptr;
+        }
+        else if(!spaceAvailable.try_take()){
+            isFull = true;
+        }
+
+        lock.lock();
+        if(writeLoan_ || (isFull && !dropOldest())){
+            lock.unlock();
+            if(!isFull) spaceAvailable.give();
+            return nullptr;
+        }
+        writeLoan_ = true;
+        loanOverwrote_ = isFull;
+        T* slot = &buffer[head];
+        lock.unlock();
+        return slot;
+    }
+
+    // Publishes the slot returned by acquire_slot()
+    void commit() {
+        lock.lock();
+        if(!writeLoan_){
+            lock.unlock();
+            return;
+        }
+        head = (head + 1) % Capacity;
+        wasOverwritten = loanOverwrote_;
+        writeLoan_ = false;
+        lock.unlock();
+        dataAvailable.give(); // Signal data is available
+        set_.notify();
+    }
+
+    // Loans the oldest item, waiting up to timeout_ms for one to arrive.
+    // Returns nullptr on timeout or if a read loan is already outstanding.
+    const T* peek_front(int timeout_ms = -1) {
+        if(!dataAvailable.take(timeout_ms)) return nullptr;
+
+        lock.lock();
+        if(readLoan_){
+            lock.unlock();
+            dataAvailable.give();
+            return nullptr;
+        }
+        readLoan_ = true;
+        const T* item = &buffer[tail];
+        lock.unlock();
+        return item;
+    }
+
+    // Removes the item returned by peek_front() and frees its slot
+    void release() {
+        lock.lock();
+        if(!readLoan_){
+            lock.unlock();
+            return;
+        }
+        tail = (tail + 1) % Capacity;
+        readLoan_ = false;
+        lock.unlock();
+        spaceAvailable.give();
+    }
+
 
     // Implementation for fidning out 
     // if last send was overwritten
     // may or may not be needed (can remove if not)
 
+    // Joins a QueueSet: every successful send sets bits in group
+    bool attach_set(EventGroup* group, uint32_t bits) {
+        set_.attach(group, bits);
+        return true;
+    }
+
     bool wasLastSendOverwritten() {
         lock.lock();
         bool flag = wasOverwritten;
@@ -191,12 +687,580 @@ public:
     }
 
 private:
+    // Drops the oldest item to make room on a full overwrite queue, taking
+    // its data token so consumers never count the slot being refilled.
+    // Fails if that item is on loan or a receiver already holds every
+    // token. Caller holds lock.
+    bool dropOldest() {
+        if(readLoan_) return false;
+        if(!dataAvailable.try_take()) return false;
+        tail = (tail + 1) % Capacity; // Overwrite oldest item
+        return true;
+    }
+
+    // Ring copies for the batch paths, at most two runs each (caller holds lock)
+    void copyIn(const T* items, size_t n) {
+        size_t first = std::min(n, Capacity - head);
+        std::copy(items, items + first, buffer + head);
+        std::copy(items + first, items + n, buffer);
+        head = (head + n) % Capacity;
+    }
+
+    void copyOut(T* items, size_t n) {
+        size_t first = std::min(n, Capacity - tail);
+        std::copy(buffer + tail, buffer + tail + first, items);
+        std::copy(buffer, buffer + (n - first), items + first);
+        tail = (tail + n) % Capacity;
+    }
+
     T buffer[Capacity];
     size_t head, tail;
     bool overwrite_;  // Whether to overwrite oldest item when full
     bool wasOverwritten = false; // Track if last item was overwritten
+    bool writeLoan_ = false;     // Producer holds buffer[head] via acquire_slot()
+    bool loanOverwrote_ = false; // That loan replaced the oldest item
+    bool readLoan_ = false;      // Consumer holds buffer[tail] via peek_front()
     Mutex lock;
+    SetLink set_;                // QueueSet this queue belongs to, if any
     CountingSemaphore spaceAvailable{Capacity, Capacity};  // Initially full space
     CountingSemaphore dataAvailable{Capacity, 0};          // Initially no data
 };
+
+//== Wait gate ==//
+// Sleep/wake helper for the lock-free queues below.
+//
+// The lock-free fast path never touches the OS. Only when an attempt fails
+// and the caller is willing to block does it register itself as a waiter
+// and park on a semaphore. The other side calls notify() after every
+// successful operation, which costs a single atomic load unless somebody
+// is actually asleep.
+class WaitGate {
+public:
+    // Repeats attempt() until it succeeds or the timeout expires.
+    // attempt must be a non-blocking operation returning true on success.
+    template <typename Attempt>
+    bool wait(Attempt attempt, int timeout_ms) {
+        if (attempt()) return true;
+        if (timeout_ms == 0) return false;
+
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::milliseconds(timeout_ms);
+        while (true) {
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (attempt()) {
+                waiters_.fetch_sub(1, std::memory_order_seq_cst);
+                chain();
+                return true;
+            }
+
+            int remaining = MAX_TIMEOUT;
+            if (timeout_ms >= 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count() + 1;
+                remaining = left > 0 ? static_cast<int>(left) : 0;
+            }
+            bool woken = remaining != 0 && wake_.take(remaining);
+            if (woken) pending_.store(false, std::memory_order_seq_cst);
+            waiters_.fetch_sub(1, std::memory_order_seq_cst);
+
+            if (!woken) {
+                // Timed out, one last look before giving up
+                if (!attempt()) return false;
+                chain();
+                return true;
+            }
+        }
+    }
+
+    // Wakes a waiter if there is one. Call after publishing new state.
+    void notify() {
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (waiters_.load(std::memory_order_relaxed) > 0) {
+            signal();
+        }
+    }
+
+private:
+    // Wake-ups coalesce into a single pending token, so a woken waiter
+    // passes the wake-up on in case more than one item arrived while it slept.
+    void chain() {
+        if (waiters_.load(std::memory_order_seq_cst) > 0) {
+            signal();
+        }
+    }
+
+    void signal() {
+        if (!pending_.exchange(true, std::memory_order_seq_cst)) {
+            wake_.give();
+        }
+    }
+
+    std::atomic<int> waiters_{0};
+    std::atomic<bool> pending_{false}; // A token sits in wake_
+    // Counting (max 1) rather than BinarySemaphore: the gate must be safe
+    // to destroy with a task still parked on it at exit, which not every
+    // backend guarantees for its binary semaphore (e.g. condvar based).
+    CountingSemaphore wake_{1, 0};
+};
+
+//== SPSC Queue abstraction ==//
+// Lock-free single-producer/single-consumer queue
+//
+// Drop-in alternative to Queue<T, N> for channels that have exactly one
+// sending task and one receiving task (e.g. sensor -> estimator). The
+// producer only writes head_ and the consumer only writes tail_, so a
+// handoff is one acquire load plus one release store, with each index on
+// its own cache line. The OS is only involved when a side has to sleep.
+//
+// Differences to Queue<T, N>:
+// - No overwrite mode: dropping the oldest item would require the
+//   producer to move tail_, which belongs to the consumer.
+// - Calling send/receive from more than one task per side is undefined.
+//
+template <typename T, size_t Capacity>
+class SpscQueue {
+    static_assert(Capacity > 0, "SpscQueue capacity must be non-zero");
+
+public:
+    SpscQueue() = default;
+
+    bool send(const T& item, int timeout_ms = -1) {
+        if (!notFull_.wait([&] { return push(item); }, timeout_ms)) {
+            return false;
+        }
+        notEmpty_.notify();
+        set_.notify();
+        return true;
+    }
+
+    bool try_send(const T& item) {
+        if (!push(item)) return false;
+        notEmpty_.notify();
+        set_.notify();
+        return true;
+    }
+
+    bool receive(T& item, int timeout_ms = -1) {
+        if (!notEmpty_.wait([&] { return pop(item); }, timeout_ms)) {
+            return false;
+        }
+        notFull_.notify();
+        return true;
+    }
+
+    bool try_receive(T& item) {
+        if (!pop(item)) return false;
+        notFull_.notify();
+        return true;
+    }
+
+    // Joins a QueueSet: every successful send sets bits in group
+    bool attach_set(EventGroup* group, uint32_t bits) {
+        set_.attach(group, bits);
+        return true;
+    }
+
+    //-- Batch operations --//
+    // Same contract as the Queue<T, N> batch calls; each run costs one
+    // index publish and at most one wake-up.
+
+    size_t send_n(const T* items, size_t n, int timeout_ms = -1) {
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::milliseconds(timeout_ms);
+        size_t sent = 0;
+        while (sent < n) {
+            int wait_ms = timeout_ms;
+            if (timeout_ms > 0 && sent > 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                wait_ms = left > 0 ? static_cast<int>(left) : 0;
+            }
+            size_t run = 0;
+            if (!notFull_.wait([&] { return (run = push_n(items + sent, n - sent)) > 0; }, wait_ms)) {
+                break;
+            }
+            notEmpty_.notify();
+            set_.notify();
+            sent += run;
+        }
+        return sent;
+    }
+
+    size_t receive_n(T* items, size_t max, int timeout_ms = -1) {
+        if (max == 0) return 0;
+        size_t run = 0;
+        if (!notEmpty_.wait([&] { return (run = pop_n(items, max)) > 0; }, timeout_ms)) {
+            return 0;
+        }
+        notFull_.notify();
+        return run;
+    }
+
+    // Slots between tail_ and head_ belong to the consumer until tail_ is
+    // published, so fn runs on them in place without any lock.
+    template <typename Fn>
+    size_t drain(Fn fn, int timeout_ms = 0) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t run = 0;
+        bool ready = notEmpty_.wait([&] {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            run = cachedHead_ - tail;
+            return run > 0;
+        }, timeout_ms);
+        if (!ready) return 0;
+
+        for (size_t i = 0; i < run; ++i) {
+            fn(static_cast<const T&>(buffer_[(tail + i) % Capacity]));
+        }
+        tail_.store(tail + run, std::memory_order_release);
+        notFull_.notify();
+        return run;
+    }
+
+    // Snapshot of the number of queued items
+    size_t size() const {
+        return head_.load(std::memory_order_acquire) -
+               tail_.load(std::memory_order_acquire);
+    }
+
+private:
+    bool push(const T& item) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        if (head - cachedTail_ == Capacity) {
+            // Looks full from the cached view, refresh from the consumer
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            if (head - cachedTail_ == Capacity) return false;
+        }
+        buffer_[head % Capacity] = item;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == cachedHead_) {
+            // Looks empty from the cached view, refresh from the producer
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            if (tail == cachedHead_) return false;
+        }
+        item = buffer_[tail % Capacity];
+        tail_.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    size_t push_n(const T* items, size_t n) {
+        const size_t head = head_.load(std::memory_order_relaxed);
+        size_t space = Capacity - (head - cachedTail_);
+        if (space < n) {
+            cachedTail_ = tail_.load(std::memory_order_acquire);
+            space = Capacity - (head - cachedTail_);
+        }
+        const size_t run = std::min(n, space);
+        const size_t idx = head % Capacity;
+        const size_t first = std::min(run, Capacity - idx);
+        std::copy(items, items + first, buffer_ + idx);
+        std::copy(items + first, items + run, buffer_);
+        head_.store(head + run, std::memory_order_release);
+        return run;
+    }
+
+    size_t pop_n(T* items, size_t max) {
+        const size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t avail = cachedHead_ - tail;
+        if (avail < max) {
+            cachedHead_ = head_.load(std::memory_order_acquire);
+            avail = cachedHead_ - tail;
+        }
+        const size_t run = std::min(max, avail);
+        const size_t idx = tail % Capacity;
+        const size_t first = std::min(run, Capacity - idx);
+        std::copy(buffer_ + idx, buffer_ + idx + first, items);
+        std::copy(buffer_, buffer_ + (run - first), items + first);
+        tail_.store(tail + run, std::memory_order_release);
+        return run;
+    }
+
+    // Producer side: write index plus its cached copy of the read index
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> head_{0};
+    size_t cachedTail_ = 0;
+    // Consumer side: read index plus its cached copy of the write index
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> tail_{0};
+    size_t cachedHead_ = 0;
+
+    alignas(CACHE_LINE_SIZE) T buffer_[Capacity];
+    WaitGate notEmpty_;  // Consumer parks here when empty
+    WaitGate notFull_;   // Producer parks here when full
+    SetLink set_;
+};
+
+//== MPMC Queue abstraction ==//
+// Lock-free bounded multi-producer/multi-consumer queue
+//
+// Same send/try_send/receive/try_receive API and overwrite semantics as
+// Queue<T, N>, for channels fed by several tasks (e.g. several RX sources). Built on
+// a ring of cells that each carry a sequence number (D. Vyukov's bounded
+// MPMC queue): a producer claims a slot with one CAS on enqueuePos_, writes
+// the payload, then publishes it by bumping the cell sequence. Producers
+// only contend on that single CAS instead of a mutex and two semaphores,
+// so cost no longer grows with the number of producing tasks.
+//
+// In overwrite mode a full queue makes the producer drop the oldest item
+// (acting as a consumer for one cell) and retry, so send never blocks.
+//
+template <typename T, size_t Capacity>
+class MpmcQueue {
+    static_assert(Capacity > 0, "MpmcQueue capacity must be non-zero");
+
+public:
+    MpmcQueue(bool overwrite = false) : overwrite_(overwrite) {
+        for (size_t i = 0; i < Capacity; ++i) {
+            cells_[i].seq.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool send(const T& item, int timeout_ms = -1) {
+        if (overwrite_) return try_send(item);
+
+        if (!notFull_.wait([&] { return push(item); }, timeout_ms)) {
+            return false;
+        }
+        wasOverwritten_.store(false, std::memory_order_relaxed);
+        notEmpty_.notify();
+        set_.notify();
+        return true;
+    }
+
+    bool try_send(const T& item) {
+        bool isFull = false;
+        while (!push(item)) {
+            if (!overwrite_) return false;
+            T dropped;
+            if (pop(dropped)) isFull = true; // Overwrite oldest item
+        }
+        wasOverwritten_.store(isFull, std::memory_order_relaxed);
+        notEmpty_.notify();
+        set_.notify();
+        return true;
+    }
+
+    bool receive(T& item, int timeout_ms = -1) {
+        if (!notEmpty_.wait([&] { return pop(item); }, timeout_ms)) {
+            return false;
+        }
+        notFull_.notify();
+        return true;
+    }
+
+    bool try_receive(T& item) {
+        if (!pop(item)) return false;
+        notFull_.notify();
+        return true;
+    }
+
+    // Joins a QueueSet: every successful send sets bits in group
+    bool attach_set(EventGroup* group, uint32_t bits) {
+        set_.attach(group, bits);
+        return true;
+    }
+
+    // As with Queue<T, N>, "last" is whichever send finished most recently
+    bool wasLastSendOverwritten() {
+        return wasOverwritten_.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> seq;
+        T data;
+    };
+
+    bool push(const T& item) {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[pos % Capacity];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - pos);
+            if (diff == 0) {
+                // Cell is free for this lap, try to claim it
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // Full: cell still holds last lap's item
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->data = item;
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool pop(T& item) {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        Cell* cell;
+        while (true) {
+            cell = &cells_[pos % Capacity];
+            size_t seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq - (pos + 1));
+            if (diff == 0) {
+                // Cell holds a published item, try to claim it
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // Empty: nothing published in this cell yet
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+        item = cell->data;
+        cell->seq.store(pos + Capacity, std::memory_order_release); // Free for next lap
+        return true;
+    }
+
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> enqueuePos_{0};
+    alignas(CACHE_LINE_SIZE) std::atomic<size_t> dequeuePos_{0};
+    alignas(CACHE_LINE_SIZE) Cell cells_[Capacity];
+    bool overwrite_;  // Whether to overwrite oldest item when full
+    std::atomic<bool> wasOverwritten_{false}; // Track if last item was overwritten
+    WaitGate notEmpty_;  // Consumers park here when empty
+    WaitGate notFull_;   // Producers park here when full
+    SetLink set_;
+};
+
+//== Mailbox abstraction ==//
+// Latest-value mailbox (seqlock) for shared state snapshots
+//
+// One writer task publishes a T, any number of readers copy the newest
+// one. Unlike Queue<T, N> in overwrite mode there is no history to drain,
+// no mutex and no semaphore on either fast path: write is two stores
+// around a memcpy, read is a copy bracketed by two loads.
+//
+// The value is double-buffered. Version v lives in slot v & 1, so the
+// writer always fills the slot readers are not being pointed at; a reader
+// only retries if the writer completes two more writes while it copies.
+// Versions start at 1; 0 means nothing has been written yet.
+//
+// wait_newer() parks a reader until the version moves past the one it
+// last saw. Up to MaxWaiters readers may block at once; each write wakes
+// all of them. Calling write from more than one task is undefined.
+//
+template <typename T, size_t MaxWaiters = 8>
+class Mailbox {
+    static_assert(std::is_trivially_copyable<T>::value, "Mailbox values are copied byte-wise");
+    static_assert(MaxWaiters > 0, "Mailbox needs room for at least one waiter");
+
+public:
+    Mailbox() = default;
+
+    void write(const T& value) {
+        const uint32_t next = version_.load(std::memory_order_relaxed) + 1;
+        Slot& slot = slots_[next & 1];
+        slot.seq.store(0, std::memory_order_relaxed);        // Mark torn for late readers
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slot.value, &value, sizeof(T));
+        slot.seq.store(next, std::memory_order_release);
+        version_.store(next, std::memory_order_seq_cst);
+
+        const int waiting = waiters_.load(std::memory_order_seq_cst);
+        if (waiting > 0) {
+            // Tokens left by readers that timed out are dropped first, so the
+            // count never exceeds the number of tasks actually parked
+            wake_.try_take_n(MaxWaiters);
+            wake_.give_n(static_cast<size_t>(waiting) < MaxWaiters ? waiting : MaxWaiters);
+        }
+    }
+
+    // Copies the newest value and returns its version (0: nothing written yet)
+    uint32_t read(T& out) const {
+        while (true) {
+            const uint32_t v = version_.load(std::memory_order_acquire);
+            if (v == 0) return 0;
+            const Slot& slot = slots_[v & 1];
+            std::memcpy(&out, &slot.value, sizeof(T));
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (slot.seq.load(std::memory_order_relaxed) == v) return v;
+        }
+    }
+
+    // Blocks until a version newer than `version` exists, copies it and
+    // updates `version`. Start from 0 to wait for the first write.
+    bool wait_newer(T& out, uint32_t& version, int timeout_ms = MAX_TIMEOUT) {
+        auto attempt = [&] {
+            if (version_.load(std::memory_order_seq_cst) == version) return false;
+            version = read(out);
+            return true;
+        };
+        if (attempt()) return true;
+        if (timeout_ms == 0) return false;
+
+        const auto deadline = std::chrono::steady_clock::now() +
+                              std::chrono::milliseconds(timeout_ms);
+        while (true) {
+            waiters_.fetch_add(1, std::memory_order_seq_cst);
+            if (attempt()) {
+                waiters_.fetch_sub(1, std::memory_order_seq_cst);
+                return true;
+            }
+
+            int remaining = MAX_TIMEOUT;
+            if (timeout_ms >= 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count() + 1;
+                remaining = left > 0 ? static_cast<int>(left) : 0;
+            }
+            bool woken = remaining != 0 && wake_.take(remaining);
+            waiters_.fetch_sub(1, std::memory_order_seq_cst);
+            if (!woken) return attempt();   // Timed out, one last look
+            // Woken (possibly by a stale token): re-check and park again if needed
+        }
+    }
+
+    uint32_t version() const { return version_.load(std::memory_order_acquire); }
+
+    Mailbox(const Mailbox&) = delete;
+    Mailbox& operator=(const Mailbox&) = delete;
+
+private:
+    struct alignas(CACHE_LINE_SIZE) Slot {
+        std::atomic<uint32_t> seq{0};
+        T value;
+    };
+
+    alignas(CACHE_LINE_SIZE) std::atomic<uint32_t> version_{0};
+    Slot slots_[2];
+    std::atomic<int> waiters_{0};
+    CountingSemaphore wake_{MaxWaiters, 0};
+};
+
+//== Persistent region ==//
+// A fixed-size byte region that keeps its contents across a crash or
+// reset, written through plain memory stores. On Linux it is a file
+// preallocated with posix_fallocate and mapped MAP_SHARED, so stores never
+// fault for lack of disk space and a killed process loses nothing already
+// stored. On the MCU it is a raw flash partition. sync() makes a range
+// durable against power loss (msync, or programming the flash pages) and
+// may block, so call it from a low-priority task.
+class PersistentRegion {
+public:
+    PersistentRegion();
+    ~PersistentRegion();
+
+    // Maps the named region, creating it (zero-filled) if it does not
+    // exist. Existing contents are kept. False on failure.
+    bool open(const char* name, size_t size);
+    void close();
+
+    uint8_t* data();                        // Null until opened
+    size_t size();
+
+    bool sync(size_t offset, size_t len);   // Durable once this returns true
+
+    PersistentRegion(const PersistentRegion&) = delete;
+    PersistentRegion& operator=(const PersistentRegion&) = delete;
+
+private:
+    struct RegionHandle;
+    RegionHandle* handle() { return std::launder(reinterpret_cast<RegionHandle*>(storage_)); }
+    alignas(HANDLE_ALIGN) unsigned char storage_[REGION_HANDLE_SIZE];
+};
 } // namespace Rtos
\ No newline at end of file
@@ -1,4 +0,0 @@
-#include "queues/queues.hpp"
-
-Rtos::Queue<msg::imu, 10> ImuQueue;
-Rtos::Queue<msg::cmd, 10> CmdQueue;
\ No newline at end of file
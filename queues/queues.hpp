@@ -1,6 +1,75 @@
 #pragma once
-#include "os/rtos.hpp"
+#include "queues/topic.hpp"
 #include "msg/messages.hpp"
 
-extern Rtos::Queue<msg::imu, 10> ImuQueue;
-extern Rtos::Queue<msg::cmd, 10> CmdQueue;
\ No newline at end of file
+// Message topics
+//
+// Every topic has a compile-time id bound to its message type and ring
+// size. Publishing to the wrong type does not compile, and a new consumer
+// only has to create a Subscription; nothing here changes.
+//
+//   Bus::Publish<Topics::IMU>(sample);
+//   Bus::Subscription<Topics::IMU> imu;            // DROP_OLDEST by default
+//   if (imu.receive(sample, 10)) { ... }
+namespace Topics {
+
+enum Id {
+    RAW_IMU,        // Sensor rate, before ImuPreprocessor
+    IMU,            // Calibrated and decimated
+    BARO,
+    GNSS,
+    EST,
+    FLIGHT_EVENT,
+    CMD,
+    CMD_ACK,
+    NUM_TOPICS
+};
+
+template <Id id> struct Spec;
+template <> struct Spec<RAW_IMU>      { using Type = msg::imu;          static constexpr size_t CAPACITY = 64; };
+template <> struct Spec<IMU>          { using Type = msg::imu;          static constexpr size_t CAPACITY = 16; };
+template <> struct Spec<BARO>         { using Type = msg::baro;         static constexpr size_t CAPACITY = 16; };
+template <> struct Spec<GNSS>         { using Type = msg::gnss;         static constexpr size_t CAPACITY = 4; };
+template <> struct Spec<EST>          { using Type = msg::est;          static constexpr size_t CAPACITY = 32; };
+template <> struct Spec<FLIGHT_EVENT> { using Type = msg::flight_event; static constexpr size_t CAPACITY = 4; };
+template <> struct Spec<CMD>          { using Type = msg::cmd;          static constexpr size_t CAPACITY = 16; };
+template <> struct Spec<CMD_ACK>      { using Type = msg::cmd_ack;      static constexpr size_t CAPACITY = 16; };
+
+template <Id id>
+using TopicOf = Bus::Topic<typename Spec<id>::Type, Spec<id>::CAPACITY>;
+
+// One instance per id, shared by every translation unit
+template <Id id>
+inline TopicOf<id> instance;
+
+// Latest-value state. Readers that only want the newest snapshot (not a
+// history) read these wait-free instead of subscribing to a topic.
+inline Rtos::Mailbox<msg::est> EstState;
+
+} // namespace Topics
+
+namespace Bus {
+
+template <Topics::Id id>
+using MessageOf = typename Topics::Spec<id>::Type;
+
+// Non-blocking; false only if a BACKPRESSURE subscriber is a full ring behind
+template <Topics::Id id>
+bool Publish(const MessageOf<id>& m) {
+    return Topics::instance<id>.try_publish(m);
+}
+
+template <Topics::Id id>
+bool Publish(const MessageOf<id>& m, int timeout_ms) {
+    return Topics::instance<id>.publish(m, timeout_ms);
+}
+
+// Subscriber bound to a topic id
+template <Topics::Id id>
+class Subscription : public Subscriber<MessageOf<id>, Topics::Spec<id>::CAPACITY> {
+public:
+    explicit Subscription(Overflow policy = Overflow::DROP_OLDEST)
+        : Subscriber<MessageOf<id>, Topics::Spec<id>::CAPACITY>(Topics::instance<id>, policy) {}
+};
+
+} // namespace Bus
@@ -0,0 +1,249 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <type_traits>
+#include "os/rtos.hpp"
+
+// Typed publish/subscribe topics
+//
+// A topic is one ring of Capacity slots. Publishers write each message
+// once; every subscriber keeps its own read cursor into the same ring, so
+// fan-out costs one write no matter how many tasks listen. Any number of
+// tasks may publish (slots are claimed with a CAS on the write index).
+//
+// Each slot carries a sequence number, 2*index+1 while it is being
+// written and 2*index+2 once complete. A reader copies the slot and
+// re-checks the sequence; if the publisher lapped it in the meantime the
+// copy is discarded and the subscriber's overflow policy decides where
+// to resume. Lossy subscribers never hold publishers back; BACKPRESSURE
+// subscribers publish their cursor, and publishers see the topic as full
+// until the slowest of them has caught up.
+namespace Bus {
+
+enum class Overflow : uint8_t {
+    DROP_OLDEST,   // Lapped: resume at the oldest message still in the ring
+    LATEST,        // Only the newest message matters, older ones are skipped
+    BACKPRESSURE,  // Lossless: publishers fail/block while this reader is a full ring behind
+};
+
+template <typename T, size_t Capacity, size_t MaxSubscribers>
+class Subscriber;
+
+template <typename T, size_t Capacity, size_t MaxSubscribers = 8>
+class Topic {
+public:
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+    static_assert(MaxSubscribers > 0, "a topic needs at least one reader slot");
+    static_assert(std::is_trivially_copyable<T>::value, "topic messages are copied byte-wise");
+
+    Topic() = default;
+    Topic(const Topic&) = delete;
+    Topic& operator=(const Topic&) = delete;
+
+    // Non-blocking, false only if a BACKPRESSURE subscriber is a full ring behind
+    bool try_publish(const T& item) {
+        uint64_t index = claim_.load(std::memory_order_relaxed);
+        do {
+            if (gated_.load(std::memory_order_acquire) > 0 && index - MinGatedCursor() >= Capacity) {
+                return false;
+            }
+        } while (!claim_.compare_exchange_weak(index, index + 1, std::memory_order_acq_rel,
+                                               std::memory_order_relaxed));
+
+        Slot& slot = slots_[index & MASK];
+        // A publisher from the previous lap may still be writing this slot
+        const uint64_t previous = index >= Capacity ? 2 * (index - Capacity) + 2 : 0;
+        while (slot.seq.load(std::memory_order_acquire) < previous) std::this_thread::yield();
+
+        slot.seq.store(2 * index + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        std::memcpy(&slot.value, &item, sizeof(T));
+        slot.seq.store(2 * index + 2, std::memory_order_release);
+
+        // Every reader has its own gate: one atomic load each unless it is asleep
+        for (Reader& r : readers_) {
+            r.readable.notify();
+            r.set.notify();
+        }
+        return true;
+    }
+
+    bool publish(const T& item, int timeout_ms = Rtos::MAX_TIMEOUT) {
+        return writable_.wait([&] { return try_publish(item); }, timeout_ms);
+    }
+
+    // Messages claimed so far (including ones still being written)
+    uint64_t published() const { return claim_.load(std::memory_order_relaxed); }
+
+private:
+    friend class Subscriber<T, Capacity, MaxSubscribers>;
+    static constexpr uint64_t MASK = Capacity - 1;
+
+    struct alignas(Rtos::CACHE_LINE_SIZE) Slot {
+        std::atomic<uint64_t> seq{0};
+        T value;
+    };
+
+    // Reader slots live in the topic, not the subscriber, so a publisher
+    // notifying a gate never races with a subscriber being destroyed
+    struct alignas(Rtos::CACHE_LINE_SIZE) Reader {
+        std::atomic<uint64_t> cursor{0};   // Only published for gated readers
+        std::atomic<bool> used{false};
+        std::atomic<bool> gated{false};
+        Rtos::WaitGate readable;
+        Rtos::SetLink set;                 // QueueSet the subscriber joined, if any
+    };
+
+    uint64_t MinGatedCursor() const {
+        uint64_t min = UINT64_MAX;
+        for (const Reader& r : readers_) {
+            if (!r.gated.load(std::memory_order_acquire)) continue;
+            const uint64_t c = r.cursor.load(std::memory_order_acquire);
+            if (c < min) min = c;
+        }
+        return min == UINT64_MAX ? claim_.load(std::memory_order_relaxed) : min;
+    }
+
+    Reader* Attach(uint64_t start, bool gated) {
+        for (Reader& r : readers_) {
+            bool expected = false;
+            if (r.used.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+                if (gated) {
+                    r.cursor.store(start, std::memory_order_release);
+                    r.gated.store(true, std::memory_order_release);
+                    gated_.fetch_add(1, std::memory_order_acq_rel);
+                }
+                return &r;
+            }
+        }
+        return nullptr;
+    }
+
+    void Detach(Reader* r) {
+        r->set.attach(nullptr, 0);
+        if (r->gated.load(std::memory_order_relaxed)) {
+            r->gated.store(false, std::memory_order_release);
+            gated_.fetch_sub(1, std::memory_order_acq_rel);
+            writable_.notify();
+        }
+        r->used.store(false, std::memory_order_release);
+    }
+
+    alignas(Rtos::CACHE_LINE_SIZE) std::atomic<uint64_t> claim_{0};
+    std::atomic<uint32_t> gated_{0};
+    Reader readers_[MaxSubscribers];
+    Slot slots_[Capacity];
+    Rtos::WaitGate writable_;   // Publishers waiting on a BACKPRESSURE subscriber
+};
+
+// One reader of a topic. Starts at the next message published after it
+// was created; owned and used by a single task. Takes one of the topic's
+// MaxSubscribers reader slots for its lifetime.
+template <typename T, size_t Capacity, size_t MaxSubscribers = 8>
+class Subscriber {
+public:
+    using TopicType = Topic<T, Capacity, MaxSubscribers>;
+
+    explicit Subscriber(TopicType& topic, Overflow policy = Overflow::DROP_OLDEST)
+        : topic_(topic), policy_(policy),
+          cursor_(topic.claim_.load(std::memory_order_acquire)) {
+        reader_ = topic_.Attach(cursor_, policy_ == Overflow::BACKPRESSURE);
+        if (!reader_ && policy_ == Overflow::BACKPRESSURE) policy_ = Overflow::DROP_OLDEST;
+    }
+
+    ~Subscriber() {
+        if (reader_) topic_.Detach(reader_);
+    }
+
+    Subscriber(const Subscriber&) = delete;
+    Subscriber& operator=(const Subscriber&) = delete;
+
+    bool try_receive(T& item) {
+        while (true) {
+            if (policy_ == Overflow::LATEST) SkipToNewest();
+
+            const typename TopicType::Slot& slot = topic_.slots_[cursor_ & TopicType::MASK];
+            const uint64_t expected = 2 * cursor_ + 2;
+            const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+            if (seq < expected) return false;              // Not published (or still being written)
+
+            if (seq == expected) {
+                std::memcpy(&item, &slot.value, sizeof(T));
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.seq.load(std::memory_order_relaxed) == expected) {
+                    Advance(cursor_ + 1);
+                    return true;
+                }
+            }
+            // Lapped by the publishers while behind or while copying
+            Resync();
+        }
+    }
+
+    bool receive(T& item, int timeout_ms = Rtos::MAX_TIMEOUT) {
+        if (reader_) return reader_->readable.wait([&] { return try_receive(item); }, timeout_ms);
+
+        // No reader slot, so nobody will wake us: poll
+        const uint64_t deadline = Rtos::NowUs() + static_cast<uint64_t>(timeout_ms) * 1000;
+        while (!try_receive(item)) {
+            if (timeout_ms >= 0 && Rtos::NowUs() >= deadline) return false;
+            Rtos::SleepMs(1);
+        }
+        return true;
+    }
+
+    // Joins a Rtos::QueueSet; needs a reader slot (see attached())
+    bool attach_set(Rtos::EventGroup* group, uint32_t bits) {
+        if (!reader_) return false;
+        reader_->set.attach(group, bits);
+        return true;
+    }
+
+    // Messages published but not yet read (may include ones already lost)
+    uint64_t pending() const { return topic_.claim_.load(std::memory_order_relaxed) - cursor_; }
+
+    // Messages this subscriber never saw because it fell behind
+    uint64_t lost() const { return lost_; }
+
+    // False if every reader slot was taken: receive() polls and BACKPRESSURE
+    // degrades to DROP_OLDEST. Size MaxSubscribers for the worst case.
+    bool attached() const { return reader_ != nullptr; }
+
+private:
+    void Advance(uint64_t next) {
+        cursor_ = next;
+        if (policy_ == Overflow::BACKPRESSURE) {
+            reader_->cursor.store(next, std::memory_order_release);
+            topic_.writable_.notify();
+        }
+    }
+
+    void Resync() {
+        const uint64_t head = topic_.claim_.load(std::memory_order_acquire);
+        // Land one slot past the oldest so a busy publisher does not lap us again at once
+        const uint64_t oldest = head > Capacity ? head - Capacity + 1 : 0;
+        if (oldest > cursor_) {
+            lost_ += oldest - cursor_;
+            Advance(oldest);
+        }
+    }
+
+    void SkipToNewest() {
+        const uint64_t head = topic_.claim_.load(std::memory_order_acquire);
+        if (head > cursor_ + 1) {
+            lost_ += head - 1 - cursor_;
+            Advance(head - 1);
+        }
+    }
+
+    TopicType& topic_;
+    Overflow policy_;
+    uint64_t cursor_;
+    uint64_t lost_ = 0;
+    typename TopicType::Reader* reader_ = nullptr;
+};
+
+} // namespace Bus
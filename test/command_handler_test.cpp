@@ -0,0 +1,109 @@
+#include "apps/CommandHandler/command_handler.hpp"
+#include "apps/StateMachine/state_machine.hpp"
+#include "queues/queues.hpp"
+#include <iostream>
+
+static bool Expect(bool cond, const char* what) {
+    if (!cond) std::cout << "[Main] FAIL: " << what << "\n";
+    return cond;
+}
+
+static int g_calls = 0;
+static bool g_allowed = false;
+
+static bool Counted(const msg::cmd&) { g_calls++; return true; }
+static bool Allowed() { return g_allowed; }
+
+static msg::cmd Cmd(msg::cmd::Type type, int32_t arg = 0, uint32_t ms = 0) {
+    return msg::cmd{type, arg, ms};
+}
+
+// Dispatch result and the ack it published must agree with the command
+static bool Acked(Bus::Subscription<Topics::CMD_ACK>& acks, const msg::cmd& c, msg::cmd_ack::Result result) {
+    msg::cmd_ack ack;
+    return acks.try_receive(ack) && ack.result == result && ack.type == c.type &&
+           ack.arg == c.arg && ack.ms == c.ms && !acks.try_receive(ack);
+}
+
+bool UnknownTest(Bus::Subscription<Topics::CMD_ACK>& acks) {
+    const msg::cmd past = Cmd(msg::cmd::NUM_TYPES, 1, 10);
+    bool ok = Expect(CommandHandler::Dispatch(past) == msg::cmd_ack::UNKNOWN && Acked(acks, past, msg::cmd_ack::UNKNOWN),
+                     "type past the table is UNKNOWN");
+    ok = Expect(!CommandHandler::Register(msg::cmd::NUM_TYPES, Counted), "Register out of range") && ok;
+
+    // An entry without a handler is as good as none
+    ok = Expect(CommandHandler::Register(msg::cmd::NOP, nullptr), "clear NOP") && ok;
+    const msg::cmd nop = Cmd(msg::cmd::NOP);
+    ok = Expect(CommandHandler::Dispatch(nop) == msg::cmd_ack::UNKNOWN && Acked(acks, nop, msg::cmd_ack::UNKNOWN),
+                "cleared entry is UNKNOWN") && ok;
+    std::cout << "[Main] Unknown commands: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool PreconditionTest(Bus::Subscription<Topics::CMD_ACK>& acks) {
+    bool ok = Expect(CommandHandler::Register(msg::cmd::NOP, Counted, Allowed), "Register with precondition");
+    const msg::cmd c = Cmd(msg::cmd::NOP, 7, 30);
+
+    g_calls = 0;
+    g_allowed = false;
+    ok = Expect(CommandHandler::Dispatch(c) == msg::cmd_ack::REJECTED && Acked(acks, c, msg::cmd_ack::REJECTED),
+                "failing precondition rejects") && ok;
+    ok = Expect(g_calls == 0, "handler not run when refused") && ok;
+
+    g_allowed = true;
+    ok = Expect(CommandHandler::Dispatch(c) == msg::cmd_ack::ACCEPTED && Acked(acks, c, msg::cmd_ack::ACCEPTED),
+                "passing precondition accepts") && ok;
+    ok = Expect(g_calls == 1, "handler run once") && ok;
+    std::cout << "[Main] Preconditions: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Built-in commands go through the StateMachine's transition table
+bool BuiltInTest(Bus::Subscription<Topics::CMD_ACK>& acks) {
+    const msg::cmd arm = Cmd(msg::cmd::ARM, 0, 40);
+    const msg::cmd disarm = Cmd(msg::cmd::DISARM, 0, 50);
+    bool ok = Expect(CommandHandler::Dispatch(arm) == msg::cmd_ack::ACCEPTED && Acked(acks, arm, msg::cmd_ack::ACCEPTED),
+                     "ARM accepted");
+    ok = Expect(CommandHandler::Dispatch(arm) == msg::cmd_ack::REJECTED && Acked(acks, arm, msg::cmd_ack::REJECTED),
+                "ARM twice rejected") && ok;
+    ok = Expect(CommandHandler::Dispatch(disarm) == msg::cmd_ack::ACCEPTED && Acked(acks, disarm, msg::cmd_ack::ACCEPTED),
+                "DISARM accepted") && ok;
+    ok = Expect(StateMachine::GetState() == StateMachine::IDLE, "back to IDLE") && ok;
+    std::cout << "[Main] Built-in commands: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool DroppedAckTest(Bus::Subscription<Topics::CMD_ACK>& acks) {
+    constexpr size_t CAPACITY = Topics::Spec<Topics::CMD_ACK>::CAPACITY;
+    const uint32_t before = CommandHandler::DroppedAcks();
+    bool ok = true;
+    {
+        // Never read: fills after CAPACITY acks, then holds up the topic
+        Bus::Subscription<Topics::CMD_ACK> stalled(Bus::Overflow::BACKPRESSURE);
+        for (size_t i = 0; i < CAPACITY + 3; ++i) {
+            const msg::cmd c = Cmd(msg::cmd::NUM_TYPES, static_cast<int32_t>(i));
+            ok = Expect(CommandHandler::Dispatch(c) == msg::cmd_ack::UNKNOWN, "dispatch while stalled") && ok;
+            msg::cmd_ack ack;
+            while (acks.try_receive(ack)) {}
+        }
+    }
+    ok = Expect(CommandHandler::DroppedAcks() - before == 3, "dropped acks counted") && ok;
+
+    // The stalled subscriber is gone: acks flow again
+    const msg::cmd c = Cmd(msg::cmd::NUM_TYPES);
+    CommandHandler::Dispatch(c);
+    ok = Expect(Acked(acks, c, msg::cmd_ack::UNKNOWN) && CommandHandler::DroppedAcks() - before == 3,
+                "acks resume") && ok;
+    std::cout << "[Main] Dropped acks: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    Bus::Subscription<Topics::CMD_ACK> acks;
+    bool ok = UnknownTest(acks);
+    ok = PreconditionTest(acks) && ok;
+    ok = BuiltInTest(acks) && ok;
+    ok = DroppedAckTest(acks) && ok;
+    std::cout << "[Main] Command Handler Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,137 @@
+#include "apps/TelemetryManager/downlink_scheduler.hpp"
+#include <cstring>
+#include <iostream>
+
+// Fake encoded message: its first byte carries an id so order can be checked
+static size_t MakeMessage(uint8_t* buf, uint8_t id, size_t len) {
+    std::memset(buf, 0, len);
+    buf[0] = id;
+    return len;
+}
+
+// Higher classes go first and several messages share one radio frame
+bool PriorityPackingTest() {
+    DownlinkScheduler s(4800);
+    uint8_t msg[32], frame[256];
+
+    s.Enqueue(DownlinkScheduler::IMU, msg, MakeMessage(msg, 3, 32), 0);
+    s.Enqueue(DownlinkScheduler::STATE, msg, MakeMessage(msg, 2, 20), 0);
+    s.Enqueue(DownlinkScheduler::EVENT, msg, MakeMessage(msg, 1, 10), 0);
+
+    size_t len = s.BuildFrame(frame, sizeof(frame), 1000);
+    bool ok = len == 62 && frame[0] == 1 && frame[10] == 2 && frame[30] == 3;
+    std::cout << "[Main] Priority + packing: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// A message that does not fit stays queued for the next frame
+bool MtuTest() {
+    DownlinkScheduler s(4800);
+    uint8_t msg[40], frame[256];
+    for (uint8_t i = 0; i < 3; ++i) s.Enqueue(DownlinkScheduler::EVENT, msg, MakeMessage(msg, i, 40), 0);
+
+    size_t first = s.BuildFrame(frame, 100, 0);
+    size_t second = s.BuildFrame(frame, 100, 0);
+    bool ok = first == 80 && second == 40 && frame[0] == 2 && s.Pending(DownlinkScheduler::EVENT) == 0;
+    std::cout << "[Main] MTU split: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// A rate-limited class waits for its bucket even when the link is idle
+bool TokenBucketTest() {
+    DownlinkScheduler s(4800);
+    s.Configure(DownlinkScheduler::IMU, {1000, 50, false});  // 1000 B/s, 50 B burst
+    uint8_t msg[40], frame[256];
+    for (uint8_t i = 0; i < 4; ++i) s.Enqueue(DownlinkScheduler::IMU, msg, MakeMessage(msg, i, 40), 1);
+
+    bool ok = s.BuildFrame(frame, sizeof(frame), 1) == 40;        // Burst covers one message
+    ok &= s.BuildFrame(frame, sizeof(frame), 10001) == 0;         // 10 + 10 B of tokens
+    ok &= s.BuildFrame(frame, sizeof(frame), 40001) == 40;        // 10 + 40 B
+    ok &= s.BuildFrame(frame, sizeof(frame), 10000001) == 40;     // Capped at the 50 B burst
+    ok &= s.Pending(DownlinkScheduler::IMU) == 1;
+    std::cout << "[Main] Token bucket: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// A message longer than the radio MTU is refused instead of blocking its class
+bool OversizeTest() {
+    DownlinkScheduler s(4800, 64);
+    uint8_t msg[DownlinkScheduler::MAX_MESSAGE_LEN], frame[256];
+    bool ok = !s.Enqueue(DownlinkScheduler::EVENT, msg, MakeMessage(msg, 0, 65), 0);
+    ok &= !s.Enqueue(DownlinkScheduler::EVENT, msg, MakeMessage(msg, 0, DownlinkScheduler::MAX_MESSAGE_LEN + 1), 0);
+    ok &= s.Enqueue(DownlinkScheduler::EVENT, msg, MakeMessage(msg, 1, 64), 0);
+    ok &= s.Stats(DownlinkScheduler::EVENT).dropped == 2 && s.Pending(DownlinkScheduler::EVENT) == 1;
+    ok &= s.BuildFrame(frame, sizeof(frame), 0) == 64 && frame[0] == 1;
+    std::cout << "[Main] Oversize message: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// A message costing more than its class's burst could never earn the
+// tokens: refused, or dropped at the head of the queue if the burst was
+// lowered after it was queued, so the messages behind it still go out
+bool BurstTest() {
+    DownlinkScheduler s(4800);
+    s.Configure(DownlinkScheduler::IMU, {1000, 50, true});
+    uint8_t msg[64], frame[256];
+    bool ok = !s.Enqueue(DownlinkScheduler::IMU, msg, MakeMessage(msg, 0, 51), 0);
+    ok &= s.Stats(DownlinkScheduler::IMU).dropped == 1;
+
+    s.Configure(DownlinkScheduler::IMU, {1000, 64, true});
+    ok &= s.Enqueue(DownlinkScheduler::IMU, msg, MakeMessage(msg, 1, 60), 0);
+    ok &= s.Enqueue(DownlinkScheduler::IMU, msg, MakeMessage(msg, 2, 20), 0);
+    s.Configure(DownlinkScheduler::IMU, {1000, 30, true});
+    ok &= s.BuildFrame(frame, sizeof(frame), 1) == 20 && frame[0] == 2;
+    ok &= s.Stats(DownlinkScheduler::IMU).dropped == 2 && s.Pending(DownlinkScheduler::IMU) == 0;
+    std::cout << "[Main] Message over burst: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Full queues drop the oldest or the newest message as configured
+bool OverflowTest() {
+    DownlinkScheduler s(4800);
+    s.Configure(DownlinkScheduler::IMU, {0, 0, true});
+    uint8_t msg[8], frame[256];
+    const size_t n = DownlinkScheduler::QUEUE_DEPTH + 3;
+    for (size_t i = 0; i < n; ++i) {
+        s.Enqueue(DownlinkScheduler::IMU, msg, MakeMessage(msg, static_cast<uint8_t>(i), 8), 0);
+        s.Enqueue(DownlinkScheduler::GNSS, msg, MakeMessage(msg, static_cast<uint8_t>(i), 8), 0);
+    }
+
+    bool ok = s.Stats(DownlinkScheduler::IMU).dropped == 3 && s.Stats(DownlinkScheduler::GNSS).dropped == 3;
+    s.BuildFrame(frame, sizeof(frame), 0);
+    ok &= frame[0] == 0;                                   // GNSS: newest three gone
+    ok &= frame[DownlinkScheduler::QUEUE_DEPTH * 8] == 3;  // IMU: oldest three gone
+    std::cout << "[Main] Overflow policy: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool StatsTest() {
+    DownlinkScheduler s(1000);
+    uint8_t msg[50], frame[256];
+    s.Enqueue(DownlinkScheduler::CMD_ACK, msg, MakeMessage(msg, 0, 50), 1000);
+    s.Enqueue(DownlinkScheduler::CMD_ACK, msg, MakeMessage(msg, 1, 50), 3000);
+    s.BuildFrame(frame, sizeof(frame), 5000);
+
+    bool ok = s.AverageLatencyUs(DownlinkScheduler::CMD_ACK) == 3000;
+    ok &= s.Stats(DownlinkScheduler::CMD_ACK).maxLatencyUs == 4000;
+
+    // 100 B sent over 1 s of a 1000 B/s link
+    float util = s.LinkUtilization(1005000);
+    ok &= util > 0.099f && util < 0.101f;
+    msg::link_stats snap = s.Snapshot(1005000);
+    ok &= snap.utilization_pm == 100 && snap.avg_latency_us[DownlinkScheduler::CMD_ACK] == 3000;
+    std::cout << "[Main] Latency + utilization: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = PriorityPackingTest();
+    ok &= MtuTest();
+    ok &= TokenBucketTest();
+    ok &= OversizeTest();
+    ok &= BurstTest();
+    ok &= OverflowTest();
+    ok &= StatsTest();
+    std::cout << "[Main] Downlink Scheduler Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,92 @@
+#include "apps/Estimator/estimator.hpp"
+#include <cmath>
+#include <iostream>
+
+// A level-at-rest IMU sample tilted by roll/pitch, plus constant gyro rates
+static msg::imu Static(float roll, float pitch, float gx, float gy, float gz, uint32_t ms) {
+    msg::imu m{};
+    m.ax = Estimator::GRAVITY * std::sin(pitch);
+    m.ay = -Estimator::GRAVITY * std::sin(roll) * std::cos(pitch);
+    m.az = -Estimator::GRAVITY * std::cos(roll) * std::cos(pitch);
+    m.gx = gx; m.gy = gy; m.gz = gz;
+    m.ms = ms;
+    return m;
+}
+
+// Accelerometer pulls roll/pitch to the true tilt
+bool TiltTest() {
+    Estimator est;
+    for (uint32_t ms = 0; ms < 5000; ++ms) est.Predict(Static(0.3f, -0.2f, 0, 0, 0, ms));
+    msg::est e = est.Estimate();
+    bool ok = std::fabs(e.roll - 0.3f) < 0.01f && std::fabs(e.pitch + 0.2f) < 0.01f;
+    std::cout << "[Main] Tilt: roll " << e.roll << " pitch " << e.pitch << (ok ? " OK" : " FAIL") << "\n";
+    return ok;
+}
+
+// A constant gyro offset at rest is learned as bias, so yaw stops drifting
+bool GyroBiasTest() {
+    Estimator est;
+    for (uint32_t ms = 0; ms < 60000; ++ms) est.Predict(Static(0, 0, 0.01f, -0.02f, 0, ms));
+    float roll0 = est.Estimate().roll;
+    float pitch0 = est.Estimate().pitch;
+    for (uint32_t ms = 60000; ms < 61000; ++ms) est.Predict(Static(0, 0, 0.01f, -0.02f, 0, ms));
+    msg::est e = est.Estimate();
+    bool ok = std::fabs(e.roll) < 0.01f && std::fabs(e.pitch) < 0.01f &&
+              std::fabs(e.roll - roll0) < 1e-3f && std::fabs(e.pitch - pitch0) < 1e-3f;
+    std::cout << "[Main] Gyro bias: roll " << e.roll << " pitch " << e.pitch << (ok ? " OK" : " FAIL") << "\n";
+    return ok;
+}
+
+// Climbing at 10 m/s: baro + accel give altitude and climb rate
+bool VerticalTest() {
+    Estimator est;
+    const float p0 = 101325.0f;
+    for (uint32_t ms = 0; ms < 20000; ++ms) {
+        est.Predict(Static(0, 0, 0, 0, 0, ms));
+        if (ms % 20 == 0) {
+            float alt = ms > 5000 ? (ms - 5000) * 0.01f : 0.0f;
+            // Invert the standard atmosphere so the estimator sees alt exactly
+            float p = p0 * std::pow(1.0f - alt / 44330.0f, 1.0f / 0.190295f);
+            est.UpdateBaro(msg::baro{p, 20.0f, ms});
+        }
+    }
+    msg::est e = est.Estimate();
+    bool ok = std::fabs(e.baro_alt - 150.0f) < 3.0f && std::fabs(e.climb - 10.0f) < 1.0f;
+    std::cout << "[Main] Vertical: alt " << e.baro_alt << " climb " << e.climb << (ok ? " OK" : " FAIL") << "\n";
+    return ok;
+}
+
+// Baro at p0 * (alt above p0) as the standard atmosphere gives it
+static float Pressure(float alt) {
+    return 101325.0f * std::pow(1.0f - alt / 44330.0f, 1.0f / 0.190295f);
+}
+
+// A lone baro outlier is gated, but a lasting offset (the state drifted,
+// or the baro reference shifted) is accepted again after a run of rejects
+bool BaroRecoveryTest() {
+    Estimator est;
+    for (uint32_t ms = 0; ms < 10000; ++ms) {
+        est.Predict(Static(0, 0, 0, 0, 0, ms));
+        if (ms % 20 == 0) est.UpdateBaro(msg::baro{Pressure(ms == 5000 ? 200.0f : 0.0f), 20.0f, ms});
+    }
+    const float afterSpike = est.Estimate().baro_alt;
+
+    for (uint32_t ms = 10000; ms < 20000; ++ms) {
+        est.Predict(Static(0, 0, 0, 0, 0, ms));
+        if (ms % 20 == 0) est.UpdateBaro(msg::baro{Pressure(200.0f), 20.0f, ms});
+    }
+    msg::est e = est.Estimate();
+    bool ok = std::fabs(afterSpike) < 0.5f && std::fabs(e.baro_alt - 200.0f) < 2.0f && std::fabs(e.climb) < 1.0f;
+    std::cout << "[Main] Baro recovery: spike " << afterSpike << " alt " << e.baro_alt << " climb " << e.climb
+              << (ok ? " OK" : " FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = TiltTest();
+    ok &= GyroBiasTest();
+    ok &= VerticalTest();
+    ok &= BaroRecoveryTest();
+    std::cout << "[Main] Estimator Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
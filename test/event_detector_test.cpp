@@ -0,0 +1,111 @@
+#include "apps/EventDetector/event_detector.hpp"
+#include "utils/sliding_window.hpp"
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+// Windows against brute force over the same samples
+bool WindowTest() {
+    constexpr size_t N = 16;
+    SlidingStats<N> stats;
+    SlidingMinMax<N> minMax;
+    std::mt19937 rng(3);
+    std::normal_distribution<float> noise(100.0f, 5.0f);
+    float history[2000];
+
+    bool ok = true;
+    for (size_t i = 0; i < 2000; ++i) {
+        history[i] = noise(rng);
+        stats.Push(history[i]);
+        minMax.Push(history[i]);
+
+        const size_t first = i + 1 >= N ? i + 1 - N : 0;
+        const size_t count = i + 1 - first;
+        float lo = history[first], hi = history[first];
+        double sum = 0.0, sq = 0.0;
+        for (size_t k = first; k <= i; ++k) {
+            lo = std::min(lo, history[k]);
+            hi = std::max(hi, history[k]);
+            sum += history[k];
+        }
+        const double mean = sum / count;
+        for (size_t k = first; k <= i; ++k) sq += (history[k] - mean) * (history[k] - mean);
+        const double var = count > 1 ? sq / (count - 1) : 0.0;
+
+        ok &= minMax.Min() == lo && minMax.Max() == hi;
+        ok &= std::fabs(stats.Mean() - mean) < 1e-3 && std::fabs(stats.Variance() - var) < 1e-2 * (1.0 + var);
+    }
+    std::cout << "[Main] Sliding windows vs brute force: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Simulated flight at 50 Hz: 5 s on the pad, 1 s boost at 60 m/s^2, coast
+// to apogee, then 8 m/s under parachute to the ground
+bool FlightTest() {
+    EventDetector det;
+    std::mt19937 rng(11);
+    std::normal_distribution<float> noise(0.0f, 0.3f);
+
+    const float padAlt = 420.0f;  // Baro reference does not have to be the pad
+    float h = 0.0f, v = 0.0f;
+    uint32_t launchMs = 0, apogeeMs = 0, landingMs = 0;
+    float apogeeAlt = 0.0f, trueApogee = 0.0f;
+    uint32_t trueApogeeMs = 0, touchdownMs = 0;
+
+    for (uint32_t ms = 0; ms < 120000; ms += 20) {
+        const float dt = 0.02f;
+        const float t = ms * 0.001f;
+        float a = 0.0f;
+        if (t >= 5.0f && t < 6.0f) a = 60.0f;
+        else if (h > 0.0f && v > -8.0f) a = -9.81f;
+        v += a * dt;
+        if (v < -8.0f) v = -8.0f;
+        h += v * dt;
+        if (h <= 0.0f && t > 6.0f) {
+            if (touchdownMs == 0) touchdownMs = ms;
+            h = 0.0f; v = 0.0f;
+        }
+        if (h > trueApogee) { trueApogee = h; trueApogeeMs = ms; }
+
+        msg::flight_event e;
+        if (det.Update(padAlt + h + noise(rng), ms, e)) {
+            if (e.type == msg::flight_event::LAUNCH && !launchMs) launchMs = ms;
+            if (e.type == msg::flight_event::APOGEE && !apogeeMs) { apogeeMs = ms; apogeeAlt = e.alt; }
+            if (e.type == msg::flight_event::LANDING && !landingMs) landingMs = ms;
+        }
+    }
+
+    bool ok = launchMs > 5000 && launchMs < 6500;
+    ok &= apogeeMs > trueApogeeMs && apogeeMs < trueApogeeMs + 2000;
+    ok &= std::fabs(apogeeAlt - trueApogee) < 5.0f;
+    ok &= landingMs > touchdownMs && landingMs < touchdownMs + 5000;
+    ok &= det.GetPhase() == EventDetector::LANDED;
+    std::cout << "[Main] Flight: launch " << launchMs << " ms, apogee " << apogeeMs << " ms (true "
+              << trueApogeeMs << ") at " << apogeeAlt << " m (true " << trueApogee << "), landing "
+              << landingMs << " ms (touchdown " << touchdownMs << ")" << (ok ? " OK" : " FAIL") << "\n";
+    return ok;
+}
+
+// Pad noise and a single spike do not fire a launch
+bool FalseTriggerTest() {
+    EventDetector det;
+    std::mt19937 rng(5);
+    std::normal_distribution<float> noise(0.0f, 0.5f);
+    bool fired = false;
+    for (uint32_t ms = 0; ms < 60000; ms += 20) {
+        float alt = 100.0f + noise(rng) + (ms == 30000 ? 50.0f : 0.0f);
+        msg::flight_event e;
+        fired |= det.Update(alt, ms, e);
+    }
+    std::cout << "[Main] No false launch: " << (!fired ? "OK" : "FAIL") << "\n";
+    return !fired;
+}
+
+int main() {
+    bool ok = WindowTest();
+    ok &= FlightTest();
+    ok &= FalseTriggerTest();
+    std::cout << "[Main] Event Detector Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,277 @@
+#include "apps/FlightRecorder/flight_recorder.hpp"
+#include "apps/FlightRecorder/flight_log.hpp"
+#include "queues/queues.hpp"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <vector>
+
+using namespace FlightLog;
+
+bool Expect(bool cond, const char* what) {
+    if (!cond) std::cout << "[Main] FAIL: " << what << "\n";
+    return cond;
+}
+
+constexpr uint8_t IMU_TYPE = FlightRecorder::RecordType(Topics::RAW_IMU);
+constexpr uint8_t CMD_TYPE = FlightRecorder::RecordType(Topics::CMD);
+constexpr uint8_t EST_TYPE = FlightRecorder::RecordType(Topics::EST);
+
+msg::imu Sample(uint32_t i) {
+    return msg::imu{0.1f * i, 0.0f, 9.81f, 0.0f, 0.0f, 0.01f * i, i};
+}
+
+void Sync(Writer& w, uint64_t us) {
+    w.BeginSync(us, 0);
+    w.EndSync();
+}
+
+// Reads every non-SYNC record; imu payloads must count up from first
+struct Contents {
+    size_t imu = 0, cmd = 0, est = 0, sync = 0;
+    bool ordered = true;
+};
+
+Contents ReadAll(Reader& r, uint32_t first = 0) {
+    Contents c;
+    Record rec;
+    uint32_t expect = first;
+    while (r.Next(rec)) {
+        if (rec.type == SYNC) { c.sync++; continue; }
+        if (rec.type == CMD_TYPE) { c.cmd++; continue; }
+        if (rec.type == EST_TYPE) { c.est++; continue; }
+        msg::imu m;
+        if (rec.type != IMU_TYPE || !rec.As(m) || m.ms != expect || m.gz != 0.01f * expect) c.ordered = false;
+        expect++;
+        c.imu++;
+    }
+    return c;
+}
+
+//== Layout on a plain buffer ==//
+
+bool RoundTripTest() {
+    std::vector<uint8_t> region(HEADER_AREA + 64 * 1024);
+    Writer w(region.data(), region.size());
+    bool ok = Expect(w.Open(), "open");
+    for (uint32_t i = 0; i < 500; ++i) {
+        ok = Expect(w.Append(IMU_TYPE, i * 1000, Sample(i)), "append") && ok;
+        if (i % 100 == 99) Sync(w, i * 1000);
+    }
+    msg::cmd c{msg::cmd::ARM, 0, 7};
+    ok = Expect(w.Append(CMD_TYPE, 600000, c), "append cmd") && ok;
+    ok = Expect(!w.Append(IMU_TYPE, 0, region.data(), MAX_PAYLOAD_LEN + 1), "oversized payload") && ok;
+    Sync(w, 600000);
+
+    Reader r(region.data(), region.size());
+    ok = Expect(r.Open(), "reader open") && ok;
+    const Contents got = ReadAll(r);
+    ok = Expect(got.imu == 500 && got.cmd == 1 && got.sync == 6 && got.ordered, "contents") && ok;
+    ok = Expect(r.Info().records == 501 && r.Info().committed == w.Used() && r.Skipped() == 0, "header") && ok;
+    std::cout << "[Main] Round trip: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool CrashTest() {
+    std::vector<uint8_t> region(HEADER_AREA + 64 * 1024);
+    Writer w(region.data(), region.size());
+    w.Open();
+    for (uint32_t i = 0; i < 100; ++i) {
+        w.Append(IMU_TYPE, i, Sample(i));
+        if (i % 50 == 49) Sync(w, i);
+    }
+
+    // Records after the last sync point, the final one torn mid-write
+    for (uint32_t i = 100; i < 150; ++i) w.Append(IMU_TYPE, i, Sample(i));
+    const uint64_t tornAt = w.Used() - (RECORD_HEADER_LEN + sizeof(msg::imu));
+    region[HEADER_AREA + tornAt + RECORD_HEADER_LEN + 3] ^= 0x5A;
+
+    // ... and the newest header copy (seq 2, slot 0) torn as well: the
+    // older one only commits 50 records, the CRCs vouch for the rest
+    region[20] ^= 0xFF;
+    Header h;
+    bool ok = Expect(!ReadHeader(region.data(), region.size(), 0, h) &&
+                     ReadHeader(region.data(), region.size(), 1, h) && h.seq == 1, "older header copy");
+
+    Reader r(region.data(), region.size());
+    ok = Expect(r.Open(), "open after crash") && ok;
+    Contents got = ReadAll(r);
+    ok = Expect(got.imu == 149 && got.ordered && r.End() == tornAt, "intact records after the sync point") && ok;
+
+    // Reopening continues after the last intact record
+    Writer again(region.data(), region.size());
+    ok = Expect(again.Open() && again.Used() == tornAt && again.Info().boots == 1, "recover") && ok;
+    for (uint32_t i = 149; i < 200; ++i) again.Append(IMU_TYPE, i, Sample(i));
+    Sync(again, 200);
+    Reader r2(region.data(), region.size());
+    r2.Open();
+    got = ReadAll(r2);
+    ok = Expect(got.imu == 200 && got.ordered && r2.Info().records == 200, "append after recover") && ok;
+    std::cout << "[Main] Crash recovery: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool CorruptionTest() {
+    std::vector<uint8_t> region(HEADER_AREA + 64 * 1024);
+    Writer w(region.data(), region.size());
+    w.Open();
+    for (uint32_t i = 0; i < 300; ++i) {
+        w.Append(IMU_TYPE, i, Sample(i));
+        if (i % 100 == 99) Sync(w, i);
+    }
+
+    // A flipped bit in record 10 loses the rest of that sync period only
+    const size_t recordLen = RECORD_HEADER_LEN + sizeof(msg::imu);
+    region[HEADER_AREA + 10 * recordLen + 5] ^= 0x01;
+    Reader r(region.data(), region.size());
+    r.Open();
+    size_t imu = 0;
+    Record rec;
+    msg::imu m;
+    uint32_t firstAfter = 0;
+    while (r.Next(rec)) {
+        if (rec.type != IMU_TYPE) continue;
+        rec.As(m);
+        if (imu == 10) firstAfter = m.ms;
+        imu++;
+    }
+    bool ok = Expect(imu == 210 && firstAfter == 100 && r.Skipped() > 0, "resync at the next sync point");
+
+    // A new log in the same region: the old records must not show through
+    Writer fresh(region.data(), region.size());
+    ok = Expect(fresh.Open(true) && fresh.Info().logId == 2 && fresh.Used() == 0, "erase") && ok;
+    fresh.Append(CMD_TYPE, 1, msg::cmd{msg::cmd::NOP, 0, 1});
+    Sync(fresh, 1);
+    Reader r2(region.data(), region.size());
+    r2.Open();
+    const Contents got = ReadAll(r2);
+    ok = Expect(got.imu == 0 && got.cmd == 1, "old log hidden") && ok;
+    std::cout << "[Main] Corruption and erase: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Records past a torn one, left by an earlier boot, must not reappear
+// after the writer resumes at the torn offset with same-sized records
+bool GhostTest() {
+    std::vector<uint8_t> region(HEADER_AREA + 64 * 1024);
+    Writer w(region.data(), region.size());
+    w.Open();
+    for (uint32_t i = 0; i < 100; ++i) w.Append(IMU_TYPE, i, Sample(i));
+    Sync(w, 100);
+    for (uint32_t i = 100; i < 110; ++i) w.Append(IMU_TYPE, i, Sample(i));
+    const uint64_t tornAt = w.Used();
+    for (uint32_t i = 110; i < 150; ++i) w.Append(IMU_TYPE, i, Sample(i));
+    region[HEADER_AREA + tornAt + RECORD_HEADER_LEN] ^= 0x5A;
+
+    // Reopened: the header at the torn record is cleared before anything is appended
+    Writer again(region.data(), region.size());
+    bool ok = Expect(again.Open() && again.Used() == tornAt, "resume at the torn record");
+    ok = Expect(region[HEADER_AREA + tornAt] == EMPTY, "torn record header cleared") && ok;
+    Sync(again, 200);
+    Reader r(region.data(), region.size());
+    r.Open();
+    Contents got = ReadAll(r);
+    ok = Expect(got.imu == 110 && got.ordered, "nothing past the resume point") && ok;
+
+    // Same-sized records line up with the old ones: the old ones behind them stay hidden
+    Writer third(region.data(), region.size());
+    third.Open();
+    for (uint32_t i = 110; i < 115; ++i) third.Append(IMU_TYPE, i, Sample(i));
+    Sync(third, 300);
+    Reader r2(region.data(), region.size());
+    r2.Open();
+    got = ReadAll(r2);
+    ok = Expect(got.imu == 115 && got.ordered, "no ghost records after the new ones") && ok;
+    std::cout << "[Main] Ghost records: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Appends between BeginSync and EndSync (the flush runs on another task)
+// are left for the next sync point
+bool ConcurrentSyncTest() {
+    std::vector<uint8_t> region(HEADER_AREA + 64 * 1024);
+    Writer w(region.data(), region.size());
+    w.Open();
+    for (uint32_t i = 0; i < 10; ++i) w.Append(IMU_TYPE, i, Sample(i));
+    const Range data = w.BeginSync(10, 0);
+    const uint64_t syncEnd = w.Used();
+    for (uint32_t i = 10; i < 20; ++i) w.Append(IMU_TYPE, i, Sample(i));
+    w.EndSync();
+
+    Header h;
+    bool ok = Expect(data.offset == HEADER_AREA && data.len == syncEnd + RECORD_HEADER_LEN, "data range");
+    ok = Expect(ReadHeader(region.data(), region.size(), 1, h) && h.committed == syncEnd && h.records == 10,
+                "commits only what BeginSync covered") && ok;
+    Sync(w, 20);
+    Reader r(region.data(), region.size());
+    r.Open();
+    const Contents got = ReadAll(r);
+    ok = Expect(got.imu == 20 && got.ordered && r.Info().records == 20 && r.Info().committed == w.Used(), "next sync point") && ok;
+    std::cout << "[Main] Appends during a sync: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool FullTest() {
+    std::vector<uint8_t> region(HEADER_AREA + 2048);
+    Writer w(region.data(), region.size());
+    w.Open();
+    uint32_t n = 0;
+    while (w.Append(IMU_TYPE, n, Sample(n))) n++;
+    Sync(w, n);   // The last sync point still fits
+    Reader r(region.data(), region.size());
+    r.Open();
+    const Contents got = ReadAll(r);
+    bool ok = Expect(w.Full() && n > 0 && got.imu == n && got.sync == 1 && got.ordered, "full log");
+    std::cout << "[Main] Full log (" << n << " records): " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+//== Recorder task on a mapped file ==//
+
+bool RecorderTest() {
+    const char* path = "flight_recorder_test.rec";
+    FlightRecorder::Configure(path, true);
+    Rtos::Task recorder;
+    recorder.Create("FlightRecorder", FlightRecorder::Run, nullptr);
+    bool ok = Expect(FlightRecorder::WaitSubscribed(1000), "subscribed");
+    Rtos::SleepMs(50);
+
+    // 1 kHz for a second, in 10 ms bursts, with an estimate per sample
+    // (as the Estimator publishes) plus a few commands
+    constexpr uint32_t SAMPLES = 1000;
+    for (uint32_t i = 0; i < SAMPLES; ++i) {
+        Bus::Publish<Topics::RAW_IMU>(Sample(i));
+        Bus::Publish<Topics::EST>(msg::est{0.0f, 0.0f, 0.0f, 0.0f, 0.0f, i});
+        if (i % 10 == 9) Rtos::SleepMs(10);
+        if (i % 250 == 0) Bus::Publish<Topics::CMD>(msg::cmd{msg::cmd::NOP, 0, i});
+    }
+    Rtos::SleepMs(FlightRecorder::SYNC_PERIOD_MS + 100);
+
+    // Read through a second mapping, as a ground tool would
+    Rtos::PersistentRegion file;
+    ok = Expect(file.open(path, FlightRecorder::REGION_SIZE), "map log") && ok;
+    Reader r(file.data(), file.size());
+    ok = Expect(r.Open(), "log header") && ok;
+    const Contents got = ReadAll(r);
+    ok = Expect(got.imu == SAMPLES && got.est == SAMPLES && got.cmd == 4 && got.ordered, "every message recorded") && ok;
+    ok = Expect(r.Info().committed == r.End() && FlightRecorder::Lost() == 0, "committed") && ok;
+    ok = Expect(FlightRecorder::Recorded() == 2 * SAMPLES + 4, "recorded count") && ok;
+    std::cout << "[Main] Recorder: " << got.imu << " IMU, " << got.est << " EST, " << got.cmd << " CMD, "
+              << got.sync << " sync points: " << (ok ? "OK" : "FAIL") << "\n";
+    file.close();
+    std::remove(path);
+    return ok;
+}
+
+int main() {
+    bool ok = RoundTripTest();
+    ok = CrashTest() && ok;
+    ok = CorruptionTest() && ok;
+    ok = GhostTest() && ok;
+    ok = ConcurrentSyncTest() && ok;
+    ok = FullTest() && ok;
+    ok = RecorderTest() && ok;
+
+    std::cout << "[Main] Flight Recorder Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,195 @@
+#include "apps/Gnss/gnss_parser.hpp"
+#include "os/rtos.hpp"
+#include <cmath>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+struct Collector {
+    std::vector<msg::gnss> fixes;
+};
+
+static bool Collect(const msg::gnss& g, void* ctx) {
+    static_cast<Collector*>(ctx)->fixes.push_back(g);
+    return true;
+}
+
+static size_t FeedString(GnssParser& p, const char* s) {
+    return p.Feed(reinterpret_cast<const uint8_t*>(s), std::strlen(s));
+}
+
+// Reference sentences from the NMEA 0183 documentation
+static const char* GGA = "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,*47\r\n";
+static const char* RMC = "$GPRMC,123519,A,4807.038,N,01131.000,E,022.4,084.4,230394,003.1,W*6A\r\n";
+
+bool GgaTest() {
+    Collector c;
+    GnssParser p(Collect, &c);
+    FeedString(p, GGA);
+    bool ok = c.fixes.size() == 1;
+    if (ok) {
+        const msg::gnss& g = c.fixes[0];
+        ok = g.fix && g.sats == 8 && std::fabs(g.lat - 48.1173) < 1e-7 &&
+             std::fabs(g.lon - (11.0 + 31.0 / 60.0)) < 1e-7 && std::fabs(g.alt - 545.4f) < 1e-3f;
+    }
+    std::cout << "[Main] GGA: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// RMC alone publishes; once GGA is seen, RMC no longer double-publishes
+bool RmcTest() {
+    Collector c;
+    GnssParser p(Collect, &c);
+    FeedString(p, RMC);
+    bool ok = c.fixes.size() == 1 && c.fixes[0].fix && std::fabs(c.fixes[0].lat - 48.1173) < 1e-7;
+    FeedString(p, GGA);
+    FeedString(p, RMC);
+    ok &= c.fixes.size() == 2 && p.GetStats().sentences == 3;
+    std::cout << "[Main] RMC: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool ChecksumTest() {
+    Collector c;
+    GnssParser p(Collect, &c);
+    std::string bad = GGA;
+    bad[20] = '9';   // Corrupt one latitude digit
+    FeedString(p, bad.c_str());
+    FeedString(p, "$GPGGA,123519,4807.038,N,01131.000,E,1,08,0.9,545.4,M,46.9,M,,\r\n");  // No checksum
+    bool ok = c.fixes.empty() && p.GetStats().checksumErrors == 2;
+    std::cout << "[Main] NMEA checksum: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Southern / western hemispheres and long fractional minutes
+bool HemisphereTest() {
+    const char* body = "GNGGA,000001.00,3351.1234567,S,15112.7654321,W,2,12,0.7,-12.345,M,0,M,,";
+    char line[128];
+    int n = std::snprintf(line, sizeof(line), "$%s*%02X\r\n", body,
+                          GnssParser::NmeaChecksum(body, std::strlen(body)));
+    Collector c;
+    GnssParser p(Collect, &c);
+    p.Feed(reinterpret_cast<const uint8_t*>(line), static_cast<size_t>(n));
+
+    bool ok = c.fixes.size() == 1;
+    if (ok) {
+        const msg::gnss& g = c.fixes[0];
+        ok = std::fabs(g.lat - -(33.0 + 51.1234567 / 60.0)) < 2e-7 &&
+             std::fabs(g.lon - -(151.0 + 12.7654321 / 60.0)) < 2e-7 && std::fabs(g.alt + 12.345f) < 1e-3f;
+    }
+    std::cout << "[Main] Hemispheres + precision: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+static size_t NavPvt(uint8_t* out, int32_t latE7, int32_t lonE7, int32_t hMslMm, uint8_t sats, bool ok) {
+    uint8_t payload[GnssParser::NAV_PVT_LEN] = {};
+    payload[20] = 3;                  // 3D fix
+    payload[21] = ok ? 0x01 : 0x00;   // gnssFixOK
+    payload[23] = sats;
+    auto put = [&](size_t at, int32_t v) {
+        for (int i = 0; i < 4; ++i) payload[at + i] = static_cast<uint8_t>(static_cast<uint32_t>(v) >> (8 * i));
+    };
+    put(24, lonE7);
+    put(28, latE7);
+    put(36, hMslMm);
+    return GnssParser::EncodeUbx(GnssParser::UBX_CLASS_NAV, GnssParser::UBX_ID_NAV_PVT,
+                                 payload, GnssParser::NAV_PVT_LEN, out);
+}
+
+// UBX and NMEA interleaved, delivered one byte at a time
+bool MixedStreamTest() {
+    std::vector<uint8_t> stream;
+    uint8_t frame[128];
+    size_t len = NavPvt(frame, 481173000, 115166667, 545400, 11, true);
+    stream.insert(stream.end(), frame, frame + len);
+    stream.insert(stream.end(), GGA, GGA + std::strlen(GGA));
+
+    uint8_t other[] = {0x01, 0x02, 0x03, 0x04};   // Some other UBX message: skipped
+    len = GnssParser::EncodeUbx(0x01, 0x35, other, sizeof(other), frame);
+    stream.insert(stream.end(), frame, frame + len);
+
+    len = NavPvt(frame, -1, -2, 3, 4, true);
+    frame[10] ^= 0xFF;                             // Broken checksum
+    stream.insert(stream.end(), frame, frame + len);
+    len = NavPvt(frame, 0, 0, 0, 0, false);        // No fix
+    stream.insert(stream.end(), frame, frame + len);
+
+    Collector c;
+    GnssParser p(Collect, &c);
+    for (uint8_t b : stream) p.Feed(&b, 1);
+
+    // GGA is ignored once NAV-PVT has been seen
+    bool ok = c.fixes.size() == 2 && p.GetStats().checksumErrors == 1 && p.GetStats().ignored == 2 &&
+              p.GetStats().sentences == 1;
+    if (ok) {
+        ok = c.fixes[0].fix && c.fixes[0].sats == 11 && std::fabs(c.fixes[0].lat - 48.1173) < 1e-7 &&
+             std::fabs(c.fixes[0].alt - 545.4f) < 1e-3f;
+        ok &= !c.fixes[1].fix && std::fabs(c.fixes[1].lat - 48.1173) < 1e-7;  // Last position kept
+    }
+    std::cout << "[Main] Mixed UBX/NMEA stream: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Wraps body as "$body*hh\r\n" and feeds it
+static size_t FeedSentence(GnssParser& p, const char* body) {
+    char line[160];
+    int n = std::snprintf(line, sizeof(line), "$%s*%02X\r\n", body,
+                          GnssParser::NmeaChecksum(body, std::strlen(body)));
+    return p.Feed(reinterpret_cast<const uint8_t*>(line), static_cast<size_t>(n));
+}
+
+// Numbers with more integer digits than the cap fail instead of overflowing
+bool DigitCapTest() {
+    Collector c;
+    GnssParser p(Collect, &c);
+    FeedSentence(p, "GPGGA,1,4807.038,N,01131.000,E,1,08,0.9,123456789.5,M,0,M,,");      // 9 digits: kept
+    FeedSentence(p, "GPGGA,1,4807.038,N,01131.000,E,1,08,0.9,99999999999999999999.5,M,0,M,,");
+    FeedSentence(p, "GPGGA,1,00000000004807.038,N,01131.000,E,1,08,0.9,0,M,0,M,,");
+    FeedSentence(p, "GPGGA,1,9999999.0,N,01131.000,E,1,08,0.9,0,M,0,M,,");                // 99999 degrees
+    bool ok = c.fixes.size() == 4;
+    if (ok) {
+        ok = c.fixes[0].fix && std::fabs(c.fixes[0].alt - 123456789.5f) < 10.0f;
+        ok &= c.fixes[1].fix && c.fixes[1].alt == c.fixes[0].alt;   // Altitude rejected, position kept
+        ok &= !c.fixes[2].fix && !c.fixes[3].fix;
+        ok &= std::fabs(c.fixes[3].lat - 48.1173) < 1e-7;            // Last good position kept
+    }
+    std::cout << "[Main] Digit cap: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// A better source only suppresses weaker ones while it keeps arriving
+bool SourceTimeoutTest() {
+    Collector c;
+    GnssParser p(Collect, &c);
+    uint8_t frame[128];
+    size_t len = NavPvt(frame, 481173000, 115166667, 545400, 11, true);
+    p.Feed(frame, len);
+    FeedString(p, GGA);
+    bool ok = c.fixes.size() == 1 && p.GetStats().ignored == 1;
+
+    // NAV-PVT output stops: GGA takes over, and then suppresses RMC
+    Rtos::SleepMs(GnssParser::SOURCE_TIMEOUT_MS + 100);
+    FeedString(p, GGA);
+    FeedString(p, RMC);
+    ok &= c.fixes.size() == 2 && c.fixes[1].sats == 8 && p.GetStats().ignored == 2;
+
+    // ... until NAV-PVT is back
+    p.Feed(frame, len);
+    FeedString(p, GGA);
+    ok &= c.fixes.size() == 3 && c.fixes[2].sats == 11 && p.GetStats().ignored == 3;
+    std::cout << "[Main] Source timeout: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = GgaTest();
+    ok &= RmcTest();
+    ok &= ChecksumTest();
+    ok &= HemisphereTest();
+    ok &= MixedStreamTest();
+    ok &= DigitCapTest();
+    ok &= SourceTimeoutTest();
+    std::cout << "[Main] GNSS Parser Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,142 @@
+#include "apps/TelemetryManager/imu_compressor.hpp"
+#include "apps/TelemetryManager/telemetry_encoder.hpp"
+#include "apps/TelemetryManager/telemetry_manager.hpp"
+#include <climits>
+#include <cmath>
+#include <iostream>
+
+bool Expect(bool cond, const char* what) {
+    if (!cond) std::cout << "[Main] FAIL: " << what << "\n";
+    return cond;
+}
+
+static const ImuCompressionConfig CONFIG;
+
+// Gravity, slow rotation, vibration and a little deterministic noise
+static msg::imu Flight(uint32_t ms) {
+    const float t = ms * 0.001f;
+    const float noise = static_cast<float>((ms * 2654435761u) >> 24) / 255.0f - 0.5f;
+    msg::imu s;
+    s.ax = 0.3f * std::sin(0.5f * t) + 0.05f * std::sin(2 * 3.14159f * 35.0f * t) + 0.04f * noise;
+    s.ay = 0.2f * std::cos(0.3f * t) - 0.04f * noise;
+    s.az = 9.81f + 0.1f * std::sin(1.1f * t) + 0.04f * noise;
+    s.gx = 0.1f * std::sin(0.7f * t) + 0.004f * noise;
+    s.gy = 0.05f * std::cos(0.2f * t) - 0.004f * noise;
+    s.gz = 0.5f + 0.004f * noise;
+    s.ms = ms;
+    return s;
+}
+
+// Every field within half an LSB, timestamps exact
+static bool Close(const msg::imu& a, const msg::imu& b) {
+    const float accel = CONFIG.accelLsb * 0.5001f, gyro = CONFIG.gyroLsb * 0.5001f;
+    return std::fabs(a.ax - b.ax) <= accel && std::fabs(a.ay - b.ay) <= accel && std::fabs(a.az - b.az) <= accel &&
+           std::fabs(a.gx - b.gx) <= gyro && std::fabs(a.gy - b.gy) <= gyro && std::fabs(a.gz - b.gz) <= gyro &&
+           a.ms == b.ms;
+}
+
+static size_t RoundTrip(const ImuCompressor& c, const msg::imu* in, size_t n, msg::imu* out, size_t* len) {
+    uint8_t block[ImuCompressor::MaxBlockBytes(ImuCompressor::MAX_BLOCK_SAMPLES)];
+    *len = c.EncodeBlock(in, n, block, sizeof(block));
+    size_t consumed = 0;
+    const size_t decoded = *len ? c.DecodeBlock(block, *len, out, &consumed) : 0;
+    return consumed == *len ? decoded : 0;
+}
+
+bool FlightDataTest() {
+    ImuCompressor c(CONFIG);
+    msg::imu in[ImuCompressor::MAX_BLOCK_SAMPLES], out[ImuCompressor::MAX_BLOCK_SAMPLES];
+    bool ok = true;
+    size_t len = 0;
+    for (size_t n = 1; n <= ImuCompressor::MAX_BLOCK_SAMPLES; n += 7) {
+        for (size_t i = 0; i < n; ++i) in[i] = Flight(static_cast<uint32_t>(5000 + i));
+        ok = Expect(RoundTrip(c, in, n, out, &len) == n, "sample count") && ok;
+        for (size_t i = 0; i < n; ++i) ok = Expect(Close(in[i], out[i]), "within half an LSB") && ok;
+        ok = Expect(len <= ImuCompressor::MaxBlockBytes(n), "within MaxBlockBytes") && ok;
+    }
+
+    // A full block at the downlink's decimated rate fits one IMU_BLOCK frame
+    const size_t n = ImuCompressor::MAX_BLOCK_SAMPLES;
+    for (size_t i = 0; i < n; ++i) in[i] = Flight(static_cast<uint32_t>(i * TelemetryManager::IMU_DOWNLINK_DECIMATION));
+    ok = Expect(RoundTrip(c, in, n, out, &len) == n, "decimated block") && ok;
+    ok = Expect(TelemetryEncoder::HEADER_LEN + len + TelemetryEncoder::CRC_LEN <= TelemetryManager::DOWNLINK_BUFFER_SIZE,
+                "decimated block fits one radio block") && ok;
+    std::cout << "[Main] Flight data (" << len << " B per " << n << " samples): " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// A single sample is only keyframes; the first sample of a block is always exact
+bool KeyframeTest() {
+    ImuCompressor c(CONFIG);
+    msg::imu in[2] = {{-3.2f, 0.004f, 9.808f, -0.0005f, 0.25f, -1.0f, 0xDEADBEEF}, Flight(7)};
+    msg::imu out[ImuCompressor::MAX_BLOCK_SAMPLES];
+    size_t len = 0;
+    bool ok = Expect(RoundTrip(c, in, 1, out, &len) == 1 && Close(in[0], out[0]), "single sample");
+    ok = Expect(RoundTrip(c, in, 2, out, &len) == 2 && Close(in[0], out[0]) && Close(in[1], out[1]), "key then delta") && ok;
+
+    // A constant channel costs no residual bits
+    msg::imu flat[ImuCompressor::MAX_BLOCK_SAMPLES];
+    for (size_t i = 0; i < ImuCompressor::MAX_BLOCK_SAMPLES; ++i) flat[i] = msg::imu{0, 0, 9.81f, 0, 0, 0, static_cast<uint32_t>(i)};
+    ok = Expect(RoundTrip(c, flat, ImuCompressor::MAX_BLOCK_SAMPLES, out, &len) == ImuCompressor::MAX_BLOCK_SAMPLES &&
+                len < 32 && Close(flat[31], out[31]), "constant block") && ok;
+    std::cout << "[Main] Keyframe: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Deltas alternating INT32_MIN and INT32_MAX need the full 32-bit width
+bool MaxWidthTest() {
+    ImuCompressor c(CONFIG);
+    const size_t n = ImuCompressor::MAX_BLOCK_SAMPLES;
+    msg::imu in[ImuCompressor::MAX_BLOCK_SAMPLES], out[ImuCompressor::MAX_BLOCK_SAMPLES];
+    uint32_t ms = 0x12345678;
+    for (size_t i = 0; i < n; ++i) {
+        in[i] = Flight(static_cast<uint32_t>(i));
+        in[i].ms = ms;
+        ms += (i % 2) ? 0x7FFFFFFFu : 0x80000000u;
+    }
+    size_t len = 0;
+    bool ok = Expect(RoundTrip(c, in, n, out, &len) == n, "sample count");
+    for (size_t i = 0; i < n; ++i) ok = Expect(Close(in[i], out[i]), "32-bit residuals round-trip") && ok;
+    ok = Expect(len >= (n - 1) * 4 && len <= ImuCompressor::MaxBlockBytes(n), "32 bits per residual") && ok;
+
+    // Truncated blocks are rejected, not decoded into garbage
+    uint8_t block[ImuCompressor::MaxBlockBytes(ImuCompressor::MAX_BLOCK_SAMPLES)];
+    len = c.EncodeBlock(in, n, block, sizeof(block));
+    ok = Expect(c.DecodeBlock(block, len - 1, out) == 0 && c.DecodeBlock(block, 1, out) == 0, "truncated block") && ok;
+    ok = Expect(c.EncodeBlock(in, n, block, len - 1) == 0, "too small for the block") && ok;
+    std::cout << "[Main] Max bit width (" << len << " B): " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Out-of-range values saturate at the int32 quantizer limits, NaN reads 0
+bool ClampTest() {
+    ImuCompressor c(CONFIG);
+    msg::imu in[4] = {{1e12f, -1e12f, INFINITY, -INFINITY, 3e9f, -3e9f, 0},
+                      {-1e12f, 1e12f, 0.0f, 0.0f, 0.0f, 0.0f, 1},
+                      {NAN, -NAN, 9.81f, NAN, INFINITY, NAN, 2},
+                      {0.5f, -0.5f, 9.81f, 0.1f, -0.1f, 0.0f, 3}};
+    msg::imu out[ImuCompressor::MAX_BLOCK_SAMPLES];
+    size_t len = 0;
+    bool ok = Expect(RoundTrip(c, in, 4, out, &len) == 4, "sample count");
+    const float accelMax = INT32_MAX * CONFIG.accelLsb, accelMin = INT32_MIN * CONFIG.accelLsb;
+    const float gyroMax = INT32_MAX * CONFIG.gyroLsb, gyroMin = INT32_MIN * CONFIG.gyroLsb;
+    ok = Expect(out[0].ax == accelMax && out[0].ay == accelMin && out[0].az == accelMax, "accel clamped") && ok;
+    ok = Expect(out[0].gx == gyroMin && out[0].gy == gyroMax && out[0].gz == gyroMin, "gyro clamped") && ok;
+    ok = Expect(out[1].ax == accelMin && out[1].ay == accelMax, "clamped both ways") && ok;
+    ok = Expect(out[2].ax == 0.0f && out[2].ay == 0.0f && out[2].gx == 0.0f && out[2].gz == 0.0f, "NaN reads 0") && ok;
+    ok = Expect(std::fabs(out[2].az - 9.81f) <= CONFIG.accelLsb && out[2].gy == gyroMax && out[2].ms == 2,
+                "rest of a NaN sample intact") && ok;
+    ok = Expect(Close(in[3], out[3]), "in-range sample after clamped ones") && ok;
+    std::cout << "[Main] Clamped quantization: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = FlightDataTest();
+    ok = KeyframeTest() && ok;
+    ok = MaxWidthTest() && ok;
+    ok = ClampTest() && ok;
+
+    std::cout << "[Main] IMU Compressor Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include "apps/ImuPreprocessor/imu_preprocessor.hpp"
+#include "apps/ImuPreprocessor/imu_kernels.hpp"
+#include <cmath>
+#include <iostream>
+#include <random>
+
+// Vector kernels match the scalar reference for every tail length
+bool KernelTest() {
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<float> u(-10.0f, 10.0f);
+    const float M[3][3] = {{1.01f, 0.02f, -0.01f}, {0.0f, 0.98f, 0.03f}, {0.01f, -0.02f, 1.02f}};
+    const float bias[3] = {0.1f, -0.2f, 0.3f};
+
+    bool ok = true;
+    for (size_t n = 0; n < 40; ++n) {
+        float a[3][40], b[3][40];
+        for (size_t i = 0; i < n; ++i)
+            for (int c = 0; c < 3; ++c) a[c][i] = b[c][i] = u(rng);
+        ImuKernels::Calibrate3(a[0], a[1], a[2], n, M, bias);
+        ImuKernels::Scalar::Calibrate3(b[0], b[1], b[2], n, M, bias);
+        for (size_t i = 0; i < n; ++i)
+            for (int c = 0; c < 3; ++c) ok &= std::fabs(a[c][i] - b[c][i]) < 1e-4f;
+
+        float d = ImuKernels::Dot(a[0], a[1] , n);
+        float e = ImuKernels::Scalar::Dot(a[0], a[1], n);
+        ok &= std::fabs(d - e) < 1e-3f * (1.0f + std::fabs(e));
+    }
+    std::cout << "[Main] Kernels (" << ImuKernels::Isa() << ") vs scalar: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Bias and scale are removed, DC passes the filter unchanged
+bool CalibrationTest() {
+    ImuCalibration cal;
+    cal.accelBias[2] = 0.5f;
+    cal.accelMatrix[2][2] = 2.0f;
+    cal.gyroBias[0] = 0.01f;
+    ImuPreprocessor pre(4, 32, cal);
+
+    msg::imu in[400], out[101];
+    for (uint32_t i = 0; i < 400; ++i) in[i] = msg::imu{1.0f, 2.0f, 3.0f, 0.02f, 0.0f, -0.1f, i};
+    size_t n = pre.Process(in, 400, out, 101);
+
+    const msg::imu& o = out[n - 1];
+    bool ok = n == 100 && std::fabs(o.ax - 1.0f) < 1e-4f && std::fabs(o.az - 5.0f) < 1e-4f &&
+              std::fabs(o.gx - 0.01f) < 1e-5f && std::fabs(o.gz + 0.1f) < 1e-5f && o.ms == 399;
+    std::cout << "[Main] Calibration + DC gain: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Output amplitude of a tone at freqHz, input at RAW_RATE_HZ
+float ToneGain(float freqHz) {
+    ImuPreprocessor pre;
+    const float fs = static_cast<float>(ImuPreprocessor::RAW_RATE_HZ);
+    msg::imu in[4000], out[1001];
+    for (uint32_t i = 0; i < 4000; ++i) {
+        in[i] = msg::imu{};
+        in[i].ax = std::sin(2.0f * 3.14159265f * freqHz * i / fs);
+    }
+    size_t n = pre.Process(in, 4000, out, 1001);
+    float peak = 0.0f;
+    for (size_t i = n / 2; i < n; ++i) peak = std::fmax(peak, std::fabs(out[i].ax));
+    return peak;
+}
+
+bool FrequencyResponseTest() {
+    float pass = ToneGain(50.0f);
+    float stop = ToneGain(1300.0f);   // Would alias to 300 Hz at 1 kHz
+    bool ok = pass > 0.95f && pass < 1.05f && stop < 0.01f;
+    std::cout << "[Main] Passband gain " << pass << ", stopband gain " << stop << (ok ? " OK" : " FAIL") << "\n";
+    return ok;
+}
+
+// Small output buffers limit how much input is consumed
+bool CapacityTest() {
+    ImuPreprocessor pre(4, 16);
+    msg::imu in[100] = {}, out[3];
+    size_t n = pre.Process(in, 100, out, 3);
+    bool ok = n == 3;
+    std::cout << "[Main] Output capacity: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = KernelTest();
+    ok &= CalibrationTest();
+    ok &= FrequencyResponseTest();
+    ok &= CapacityTest();
+    std::cout << "[Main] IMU Preprocessor Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
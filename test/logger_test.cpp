@@ -0,0 +1,158 @@
+#include "apps/Logger/logger.hpp"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Captures lines instead of printing them; only the drain calls it
+std::vector<std::string> lines;
+void Capture(const char* line, size_t len) { lines.emplace_back(line, len); }
+
+bool Expect(bool cond, const char* what) {
+    if (!cond) std::cout << "[Main] FAIL: " << what << "\n";
+    return cond;
+}
+
+template <typename... Args>
+std::string Formatted(const char* fmt, const Args&... args) {
+    Logger::Info(fmt, args...);
+    lines.clear();
+    Logger::Flush();
+    return lines.empty() ? "" : lines.back();
+}
+
+enum Mode { SAFE = 2 };
+
+bool FormatTest() {
+    bool ok = true;
+    const char* name = "ARMED";
+    ok = Expect(Formatted("plain") == "plain", "plain") && ok;
+    ok = Expect(Formatted("%d %i %u", -5, int16_t{-7}, 42u) == "-5 -7 42", "ints") && ok;
+    ok = Expect(Formatted("%ld %llu %zu", -1234567890123L, 18446744073709551615ull, size_t{9}) ==
+                "-1234567890123 18446744073709551615 9", "length modifiers") && ok;
+    ok = Expect(Formatted("%05d|%-4d|%+d|%x|%#X", 42, 7, 3, 255u, 255) == "00042|7   |+3|ff|0XFF", "flags") && ok;
+    ok = Expect(Formatted("%.2f %8.3f %g", 3.14159, -1.5f, 0.25) == "3.14   -1.500 0.25", "floats") && ok;
+    ok = Expect(Formatted("%s -> %s, 100%%", name, "IDLE") == "ARMED -> IDLE, 100%", "strings") && ok;
+    ok = Expect(Formatted("%d %d %c", true, SAFE, 'A') == "1 2 A", "bool, enum, char") && ok;
+    ok = Expect(Formatted("%s", static_cast<const char*>(nullptr)) == "(null)", "null string") && ok;
+
+    // Mismatches are coerced to the stored type, missing arguments copied as text
+    ok = Expect(Formatted("%s %f", 12, 7) == "12 7", "mismatch") && ok;
+    ok = Expect(Formatted("%d and %d", 1) == "1 and %d", "missing") && ok;
+    ok = Expect(Formatted("%n %d", 1) == "%n 1", "unsupported") && ok;
+
+    Logger::Warn("low battery %d%%", 20);
+    Logger::Error("sensor %s lost", "IMU");
+    lines.clear();
+    Logger::Flush();
+    ok = Expect(lines.size() == 2 && lines[0] == "WARN: low battery 20%" && lines[1] == "ERROR: sensor IMU lost",
+                "levels") && ok;
+
+    // Truncated to the output buffer, always terminated
+    char small[8];
+    Logger::Record r{};
+    r.fmt = "%s";
+    r.level = Logger::INFO;
+    r.count = 1;
+    r.types[0] = Logger::STR;
+    r.args[0].s = "0123456789";
+    const size_t n = Logger::Format(r, small, sizeof(small));
+    ok = Expect(n == 7 && std::strcmp(small, "0123456") == 0, "truncation") && ok;
+
+    Logger::SetLevel(Logger::WARN);
+    Logger::Info("filtered");
+    Logger::Debug("filtered");
+    lines.clear();
+    Logger::Flush();
+    ok = Expect(lines.empty(), "level filter") && ok;
+    Logger::SetLevel(Logger::DEBUG);
+
+    std::cout << "[Main] Format: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Several tasks log while the drain task runs; nothing may be lost or
+// reordered within a task, and lines come out merged by time
+constexpr int NUM_TASKS = 4;
+constexpr int PER_TASK = 1000;
+
+void Producer(void* arg) {
+    const long id = reinterpret_cast<long>(arg);
+    for (int i = 0; i < PER_TASK; ++i) {
+        Logger::Info("task %ld line %d", id, i);
+        // A quarter ring per drain period, so nothing is dropped
+        if (i % (Logger::RING_DEPTH / 4) == 0) Rtos::SleepMs(Logger::DRAIN_PERIOD_MS);
+    }
+}
+
+bool MultiTaskTest() {
+    lines.clear();
+    const uint64_t writtenBefore = Logger::Written();
+    Rtos::Task drain;
+    drain.Create("Logger", Logger::Run, nullptr);
+
+    Rtos::Task producers[NUM_TASKS];
+    for (long i = 0; i < NUM_TASKS; ++i) producers[i].Create("Producer", Producer, reinterpret_cast<void*>(i));
+    for (auto& p : producers) p.Join();
+    Logger::Flush();
+
+    int next[NUM_TASKS] = {};
+    bool ok = Logger::Dropped() == 0;
+    for (const std::string& line : lines) {
+        long id;
+        int i;
+        if (std::sscanf(line.c_str(), "task %ld line %d", &id, &i) != 2 || id < 0 || id >= NUM_TASKS) {
+            ok = false;
+            continue;
+        }
+        if (i != next[id]) ok = false;
+        next[id] = i + 1;
+    }
+    for (int n : next) ok = ok && n == PER_TASK;
+    ok = ok && Logger::Written() - writtenBefore == static_cast<uint64_t>(NUM_TASKS * PER_TASK);
+    std::cout << "[Main] " << NUM_TASKS << " tasks, " << lines.size() << " lines in order: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// A burst larger than the ring drops the excess and says so
+std::atomic<bool> burstDone{false};
+
+void Burst(void*) {
+    for (size_t i = 0; i < Logger::RING_DEPTH + 50; ++i) Logger::Info("burst %d", static_cast<int>(i));
+    burstDone = true;
+}
+
+bool DropTest() {
+    const uint64_t droppedBefore = Logger::Dropped();
+    lines.clear();
+    Rtos::Task burst;
+    burst.Create("Burst", Burst, nullptr);
+    burst.Join();
+    Logger::Flush();
+
+    // The drain task may have emptied the ring mid-burst, so allow fewer drops
+    const uint64_t dropped = Logger::Dropped() - droppedBefore;
+    size_t burstLines = 0;
+    unsigned long long reported = 0, n;
+    for (const std::string& line : lines) {
+        if (line.rfind("burst ", 0) == 0) burstLines++;
+        if (std::sscanf(line.c_str(), "[Logger] %llu records dropped", &n) == 1) reported += n;
+    }
+    bool ok = burstDone && burstLines + dropped == Logger::RING_DEPTH + 50 && burstLines >= Logger::RING_DEPTH;
+    ok = ok && reported == dropped;
+    std::cout << "[Main] Burst: " << burstLines << " written, " << dropped << " dropped: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    Logger::SetSink(Capture);
+    bool ok = FormatTest();
+    ok = MultiTaskTest() && ok;
+    ok = DropTest() && ok;
+
+    std::cout << "[Main] Logger Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
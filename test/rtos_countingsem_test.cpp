@@ -1,5 +1,5 @@
 #include "os/rtos.hpp"
-#include <iostream>
+#include "apps/Logger/logger.hpp"
 
 Rtos::CountingSemaphore sem(3,3);  
 // Allows 3 threads to enter the critical section
@@ -12,32 +12,30 @@ struct ThreadData {
 constexpr int NUM_WORKERS = 6;
 ThreadData threadData[NUM_WORKERS];  // Static allocation
 
-Rtos::Mutex mutex;  // Mutex to protect console output
+// Console output goes through the deferred logger: workers never contend
+// on a console lock while they hold a permit
 
 void Worker(void* arg) {
     auto* data = static_cast<ThreadData*>(arg);
     int id = data->id;
 
-    mutex.lock();  // Lock mutex for console output
-    std::cout << "[Worker " << id << "] Waiting for permit...\n";
-    mutex.unlock();  // Unlock after printing
+    Logger::Info("[Worker %d] Waiting for permit...", id);
 
     sem.take();  // Block until allowed in
 
-    mutex.lock();  // Lock again for console output
-    std::cout << "[Worker " << id << "] Acquired permit, working...\n";
-    mutex.unlock();  // Unlock after printing
+    Logger::Info("[Worker %d] Acquired permit, working...", id);
     
     Rtos::SleepMs(500);  // Simulate work
     
-    mutex.lock();  // Lock for console output
-    std::cout << "[Worker " << id << "] Releasing permit...\n";
-    mutex.unlock();  // Unlock after printing
+    Logger::Info("[Worker %d] Releasing permit...", id);
 
     sem.give();  // Release permit
 }
 
 int main() {
+    Rtos::Task logger;
+    logger.Create("Logger", Logger::Run, nullptr);
+
     Rtos::Task workers[NUM_WORKERS];
 
     for (int i = 0; i < NUM_WORKERS; ++i) {
@@ -49,6 +47,7 @@ int main() {
         workers[i].Join();
     }
 
-    std::cout << "[Main] All workers completed.\n";
+    Logger::Info("[Main] All workers completed.");
+    Logger::Flush();
     return 0;
 }
@@ -0,0 +1,108 @@
+#include "os/rtos.hpp"
+#include "apps/Logger/logger.hpp"
+#include <cstdint>
+#include <iostream>
+
+// State vector large enough that a torn copy would be visible
+struct State {
+    uint32_t version;
+    uint32_t words[30];
+};
+
+Rtos::Mailbox<State> mailbox;
+constexpr uint32_t NUM_WRITES = 200000;
+constexpr int NUM_POLLERS = 2;
+constexpr int NUM_WAITERS = 2;
+
+std::atomic<bool> writerDone{false};
+std::atomic<int> errors{0};
+long pollReads[NUM_POLLERS];
+long waitReads[NUM_WAITERS];
+
+bool Consistent(const State& s) {
+    for (uint32_t w : s.words) {
+        if (w != s.version) return false;
+    }
+    return true;
+}
+
+void Writer(void*) {
+    State s;
+    for (uint32_t v = 1; v <= NUM_WRITES; ++v) {
+        s.version = v;
+        for (auto& w : s.words) w = v;
+        mailbox.write(s);
+    }
+    writerDone.store(true, std::memory_order_release);
+}
+
+// Spins on read(): every copy must be whole and versions never go back
+void Poller(void* arg) {
+    long& reads = *static_cast<long*>(arg);
+    uint32_t last = 0;
+    State s;
+    while (!writerDone.load(std::memory_order_acquire)) {
+        uint32_t v = mailbox.read(s);
+        if (v == 0) continue;
+        if (v < last || s.version != v || !Consistent(s)) errors++;
+        last = v;
+        reads++;
+    }
+}
+
+// Blocks for each newer version; may skip some but never sees one twice
+void Waiter(void* arg) {
+    long& reads = *static_cast<long*>(arg);
+    uint32_t version = 0;
+    State s;
+    while (version < NUM_WRITES) {
+        uint32_t previous = version;
+        if (!mailbox.wait_newer(s, version, 1000)) {
+            Logger::Error("[Waiter] wait_newer timed out at version %u", version);
+            errors++;
+            return;
+        }
+        if (version <= previous || s.version != version || !Consistent(s)) errors++;
+        reads++;
+    }
+}
+
+bool BasicTest() {
+    Rtos::Mailbox<int> box;
+    int value = -1;
+    uint32_t version = 0;
+    bool ok = box.read(value) == 0 && box.version() == 0;
+    ok = ok && !box.wait_newer(value, version, 0);          // Nothing written yet
+    ok = ok && !box.wait_newer(value, version, 20);         // ... and times out
+
+    box.write(1);
+    box.write(2);
+    ok = ok && box.read(value) == 2 && value == 2;          // Only the newest is kept
+    ok = ok && box.wait_newer(value, version, 0) && version == 2 && value == 2;
+    ok = ok && !box.wait_newer(value, version, 0);          // Already seen
+    std::cout << "[Main] Basic: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = BasicTest();
+
+    Rtos::Task pollers[NUM_POLLERS];
+    Rtos::Task waiters[NUM_WAITERS];
+    Rtos::Task writer;
+    for (int i = 0; i < NUM_POLLERS; ++i) pollers[i].Create("Poller", Poller, &pollReads[i]);
+    for (int i = 0; i < NUM_WAITERS; ++i) waiters[i].Create("Waiter", Waiter, &waitReads[i]);
+    writer.Create("Writer", Writer, nullptr);
+
+    writer.Join();
+    for (auto& p : pollers) p.Join();
+    for (auto& w : waiters) w.Join();
+    Logger::Flush();   // Task-side errors before the summary
+
+    for (int i = 0; i < NUM_POLLERS; ++i) std::cout << "[Poller " << i + 1 << "] " << pollReads[i] << " reads\n";
+    for (int i = 0; i < NUM_WAITERS; ++i) std::cout << "[Waiter " << i + 1 << "] " << waitReads[i] << " reads\n";
+
+    ok = ok && errors.load() == 0 && mailbox.version() == NUM_WRITES;
+    std::cout << "[Main] Mailbox Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
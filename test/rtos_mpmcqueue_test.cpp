@@ -0,0 +1,89 @@
+#include "os/rtos.hpp"
+#include "apps/Logger/logger.hpp"
+#include <iostream>
+
+// Several producers and consumers share one small queue
+Rtos::MpmcQueue<long, 8> queue;
+constexpr int NUM_PRODUCERS = 3;
+constexpr int NUM_CONSUMERS = 2;
+constexpr long ITEMS_PER_PRODUCER = 50000;
+constexpr int TIMEOUT_MS = 1000;
+
+struct ThreadData {
+    int id;
+    long sum;
+    long count;
+};
+
+ThreadData producerData[NUM_PRODUCERS];
+ThreadData consumerData[NUM_CONSUMERS];
+
+void Producer(void* arg) {
+    auto* data = static_cast<ThreadData*>(arg);
+    for (long i = 1; i <= ITEMS_PER_PRODUCER; ++i) {
+        if (!queue.send(i, TIMEOUT_MS)) {
+            Logger::Error("[Producer %d] Send timed out", data->id);
+            return;
+        }
+        data->sum += i;
+        data->count++;
+    }
+}
+
+void Consumer(void* arg) {
+    auto* data = static_cast<ThreadData*>(arg);
+    long value;
+    // Stop once the producers have gone quiet for a while
+    while (queue.receive(value, 200)) {
+        data->sum += value;
+        data->count++;
+    }
+}
+
+bool OverwriteTest() {
+    Rtos::MpmcQueue<int, 3> ring(true);
+    for (int i = 1; i <= 5; ++i) ring.send(i);
+    bool ok = ring.wasLastSendOverwritten();
+
+    // Oldest two items were dropped, 3..5 must remain in order
+    int value;
+    for (int expected = 3; expected <= 5; ++expected) {
+        ok = ok && ring.try_receive(value) && value == expected;
+    }
+    ok = ok && !ring.try_receive(value);
+    std::cout << "[Main] Overwrite mode: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = OverwriteTest();
+
+    Rtos::Task producers[NUM_PRODUCERS];
+    Rtos::Task consumers[NUM_CONSUMERS];
+
+    for (int i = 0; i < NUM_CONSUMERS; ++i) {
+        consumerData[i] = ThreadData{i + 1, 0, 0};
+        consumers[i].Create("Consumer", Consumer, &consumerData[i]);
+    }
+    for (int i = 0; i < NUM_PRODUCERS; ++i) {
+        producerData[i] = ThreadData{i + 1, 0, 0};
+        producers[i].Create("Producer", Producer, &producerData[i]);
+    }
+
+    for (auto& p : producers) p.Join();
+    for (auto& c : consumers) c.Join();
+    Logger::Flush();   // Task-side errors before the summary
+
+    long sent = 0, sentSum = 0, received = 0, receivedSum = 0;
+    for (auto& d : producerData) { sent += d.count; sentSum += d.sum; }
+    for (auto& d : consumerData) {
+        std::cout << "[Consumer " << d.id << "] Received " << d.count << " items\n";
+        received += d.count;
+        receivedSum += d.sum;
+    }
+
+    ok = ok && sent == received && sentSum == receivedSum;
+    std::cout << "[Main] Sent " << sent << ", received " << received << "\n";
+    std::cout << "[Main] MPMC Queue Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
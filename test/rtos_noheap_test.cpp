@@ -0,0 +1,65 @@
+#include "os/rtos.hpp"
+#include <cstdlib>
+#include <iostream>
+#include <new>
+
+// Counts every C++ heap allocation made by the process
+static size_t g_allocations = 0;
+
+void* operator new(size_t size) {
+    g_allocations++;
+    if (void* p = std::malloc(size)) return p;
+    throw std::bad_alloc();
+}
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete(void* p, size_t) noexcept { std::free(p); }
+
+// Global primitives, constructed during static initialization
+Rtos::Queue<int, 8> queue;
+Rtos::SpscQueue<int, 8> spscQueue;
+Rtos::MpmcQueue<int, 8> mpmcQueue;
+Rtos::Mutex mutex;
+Rtos::BinarySemaphore sem;
+Rtos::CountingSemaphore countingSem(4, 0);
+
+void Worker(void*) {
+    for (int i = 0; i < 100; ++i) {
+        queue.send(i);
+        spscQueue.send(i);
+        mpmcQueue.send(i);
+    }
+    sem.give();
+}
+
+int main() {
+    size_t atStartup = g_allocations;
+
+    Rtos::Task worker;
+    Rtos::Mutex localMutex;
+    worker.Create("Worker", Worker, nullptr);
+
+    int value;
+    for (int i = 0; i < 100; ++i) {
+        queue.receive(value);
+        spscQueue.receive(value);
+        mpmcQueue.receive(value);
+        mutex.lock();
+        mutex.unlock();
+    }
+    sem.take();
+    countingSem.give();
+    countingSem.take();
+    worker.Join();
+
+    // Printing may allocate, so read the counter first
+    size_t atRuntime = g_allocations - atStartup;
+    std::cout << "[Main] Heap allocations during static init: " << atStartup << "\n";
+    std::cout << "[Main] Heap allocations at runtime: " << atRuntime << "\n";
+    std::cout << "[Main] Task handle " << Rtos::TASK_HANDLE_SIZE << " B, mutex "
+              << Rtos::MUTEX_HANDLE_SIZE << " B, semaphore " << Rtos::SEMAPHORE_HANDLE_SIZE
+              << " B, counting semaphore " << Rtos::COUNTING_SEM_HANDLE_SIZE << " B\n";
+
+    bool ok = atStartup == 0 && atRuntime == 0;
+    std::cout << "[Main] No Heap Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
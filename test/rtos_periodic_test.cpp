@@ -0,0 +1,114 @@
+#include "os/rtos.hpp"
+#include <algorithm>
+#include <climits>
+#include <cstdint>
+#include <iostream>
+
+constexpr uint32_t BASE_PERIOD_US = 1000;   // 1 kHz
+constexpr int RUN_MS = 500;
+
+// Release timestamps and indices of the 1 kHz member, to measure drift and jitter
+constexpr int MAX_SAMPLES = 1000;
+uint64_t releases[MAX_SAMPLES];
+uint64_t indices[MAX_SAMPLES];
+int numReleases = 0;
+
+Rtos::PeriodicTask* base = nullptr;
+bool injectOverruns = false;
+int fastCount = 0, mediumCount = 0, slowCount = 0;
+
+void FastStep(void*) {
+    const uint64_t k = base->release();
+    if (numReleases < MAX_SAMPLES) {
+        releases[numReleases] = Rtos::NowUs();
+        indices[numReleases++] = k;
+    }
+    fastCount++;
+    if (injectOverruns && k % 50 == 25) Rtos::SleepUntilUs(Rtos::NowUs() + 2500);  // Skips two or three releases
+}
+void MediumStep(void*) { mediumCount++; }
+void SlowStep(void*) { slowCount++; }
+
+void SlowJob(void*) { Rtos::SleepMs(3); }  // Always overruns a 1 ms period
+
+void RunGroup(Rtos::PeriodicTask& task, bool overruns) {
+    numReleases = fastCount = mediumCount = slowCount = 0;
+    injectOverruns = overruns;
+    base = &task;
+    Rtos::RateGroup group;
+    group.Add(FastStep, nullptr, 1);      // 1 kHz
+    group.Add(MediumStep, nullptr, 10);   // 100 Hz
+    group.Add(SlowStep, nullptr, 100);    // 10 Hz
+    group.Start(task, "RateGroup", BASE_PERIOD_US);
+    Rtos::SleepMs(RUN_MS);
+    task.Stop();
+    task.Join();
+}
+
+// Number of divider-release windows that had a tick: a member runs once in each
+int Windows(uint32_t divider) {
+    int n = 0;
+    for (int i = 0; i < numReleases; ++i) {
+        if (i == 0 || indices[i] / divider != indices[i - 1] / divider) n++;
+    }
+    return n;
+}
+
+int main() {
+    Rtos::PeriodicTask clean;
+    RunGroup(clean, false);
+
+    // Lateness of each release against its slot on the grid started by the
+    // first one, t0 + k * period. Skipped releases (overruns) move k, but
+    // never the grid itself. Scheduler stalls make single releases late, so
+    // the phase error is the median lateness, and drift is the best-case
+    // lateness near the end of the run: with relative sleeps both grow
+    // with every job.
+    static int64_t late[MAX_SAMPLES];
+    int64_t endLate = INT64_MAX;
+    for (int i = 0; i < numReleases; ++i) {
+        late[i] = static_cast<int64_t>(releases[i] - releases[0]) -
+                  static_cast<int64_t>((indices[i] - indices[0]) * BASE_PERIOD_US);
+        if (i >= numReleases - 50 && late[i] < endLate) endLate = late[i];
+    }
+    std::nth_element(late, late + numReleases / 2, late + numReleases);
+    const int64_t phaseError = late[numReleases / 2];
+
+    std::cout << "[Main] Cycles: " << clean.cycles() << ", overruns: " << clean.overruns() << "\n";
+    std::cout << "[Main] 1 kHz: " << fastCount << ", 100 Hz: " << mediumCount
+              << ", 10 Hz: " << slowCount << "\n";
+    std::cout << "[Main] Median phase error: " << phaseError << " us, drift over run: "
+              << endLate << " us\n";
+
+    // Members run once per divider base releases, whatever the scheduling noise
+    bool ok = mediumCount == Windows(10) && slowCount == Windows(100);
+    // Absolute deadlines: on time and no accumulated drift beyond jitter
+    ok = ok && phaseError < static_cast<int64_t>(BASE_PERIOD_US / 4);
+    ok = ok && endLate < static_cast<int64_t>(BASE_PERIOD_US / 4);
+
+    // Overruns skip base releases; the slower members keep wall-clock rate,
+    // running once per divider releases rather than once per divider jobs
+    Rtos::PeriodicTask overrunning;
+    RunGroup(overrunning, true);
+    std::cout << "[Main] With overruns: cycles " << overrunning.cycles() << ", overruns "
+              << overrunning.overruns() << ", 100 Hz: " << mediumCount << ", 10 Hz: " << slowCount << "\n";
+    ok = ok && overrunning.overruns() >= 10;
+    ok = ok && mediumCount == Windows(10) && slowCount == Windows(100);
+    ok = ok && mediumCount > (fastCount + 9) / 10;
+
+    Rtos::PeriodicTask slow;
+    slow.Create("Overrun", BASE_PERIOD_US, SlowJob, nullptr);
+    Rtos::SleepMs(50);
+    slow.Stop();
+    slow.Join();
+    std::cout << "[Main] Overrunning job: cycles " << slow.cycles()
+              << ", overruns " << slow.overruns() << "\n";
+    ok = ok && slow.overruns() >= slow.cycles();
+
+    // A zero period is refused instead of dividing by zero on the first overrun
+    Rtos::PeriodicTask zero;
+    ok = ok && !zero.Create("Zero", 0, SlowJob, nullptr);
+
+    std::cout << "[Main] Periodic Task Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
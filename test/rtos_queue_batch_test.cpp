@@ -0,0 +1,94 @@
+#include "os/rtos.hpp"
+#include "apps/Logger/logger.hpp"
+#include <iostream>
+
+// Batch send_n/receive_n/drain on both the locked and the SPSC queue
+Rtos::Queue<int, 7> queue;
+Rtos::SpscQueue<int, 7> spscQueue;
+constexpr int NUM_ITEMS = 10000;
+constexpr int BATCH = 5;  // Not a divisor of the capacity, so runs wrap
+constexpr int TIMEOUT_MS = 1000;
+
+int errors = 0;
+
+template <typename Q>
+void Producer(void* arg) {
+    auto* q = static_cast<Q*>(arg);
+    int batch[BATCH];
+    for (int next = 1; next <= NUM_ITEMS; next += BATCH) {
+        for (int i = 0; i < BATCH; ++i) batch[i] = next + i;
+        if (q->send_n(batch, BATCH, TIMEOUT_MS) != BATCH) {
+            Logger::Error("[Producer] send_n timed out");
+            return;
+        }
+    }
+}
+
+template <typename Q>
+void Consumer(void* arg) {
+    auto* q = static_cast<Q*>(arg);
+    int batch[3];
+    int expected = 1;
+    while (expected <= NUM_ITEMS) {
+        size_t n = q->receive_n(batch, 3, TIMEOUT_MS);
+        if (n == 0) {
+            Logger::Error("[Consumer] receive_n timed out");
+            errors++;
+            return;
+        }
+        for (size_t i = 0; i < n; ++i) {
+            if (batch[i] != expected++) errors++;
+        }
+    }
+}
+
+template <typename Q>
+bool StreamTest(const char* name, Q& q) {
+    int before = errors;
+    Rtos::Task producerTask, consumerTask;
+    consumerTask.Create("Consumer", Consumer<Q>, &q);
+    producerTask.Create("Producer", Producer<Q>, &q);
+    producerTask.Join();
+    consumerTask.Join();
+    Logger::Flush();   // Task-side errors before the summary
+    bool ok = errors == before;
+    std::cout << "[Main] " << name << " send_n/receive_n stream: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+template <typename Q>
+bool DrainTest(const char* name, Q& q) {
+    int items[] = {1, 2, 3, 4};
+    q.send_n(items, 4, 0);
+    int sum = 0;
+    size_t n = q.drain([&](const int& v) { sum += v; });
+    bool ok = n == 4 && sum == 10 && q.drain([](const int&) {}) == 0;
+    std::cout << "[Main] " << name << " drain: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool OverwriteTest() {
+    Rtos::Queue<int, 4> ring(true);
+    int items[] = {1, 2, 3, 4, 5, 6};
+    ring.send_n(items, 3);
+    ring.send_n(items + 3, 3);  // Drops 1 and 2
+
+    int out[4];
+    size_t n = ring.receive_n(out, 4, 0);
+    bool ok = ring.wasLastSendOverwritten() && n == 4 &&
+              out[0] == 3 && out[1] == 4 && out[2] == 5 && out[3] == 6;
+    std::cout << "[Main] Queue overwrite send_n: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = true;
+    ok &= StreamTest("Queue", queue);
+    ok &= StreamTest("SpscQueue", spscQueue);
+    ok &= DrainTest("Queue", queue);
+    ok &= DrainTest("SpscQueue", spscQueue);
+    ok &= OverwriteTest();
+
+    std::cout << "[Main] Queue Batch Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
@@ -1,5 +1,5 @@
 #include "os/rtos.hpp"
-#include <iostream>
+#include "apps/Logger/logger.hpp"
 
 // Define the queue type with int messages and size 5
 Rtos::Queue<int, 5> queue;
@@ -7,43 +7,47 @@ constexpr int PRODUCER_TIMEOUT_MS = 1000;
 constexpr int CONSUMER_TIMEOUT_MS = 1000;
 
 void Producer(void*) {
-    std::cout << "[Producer] Thread started\n";
+    Logger::Info("[Producer] Thread started");
     for (int i = 1; i <= 10; ++i) {
         if(queue.send(i, PRODUCER_TIMEOUT_MS)){ // Now blocks if queue is full
-            std::cout << "[Producer] Sent: " << i << std::endl;
+            Logger::Info("[Producer] Sent: %d", i);
         }
-        else std::cout << "[Producer] Send timed out!\n";
+        else Logger::Warn("[Producer] Send timed out!");
         Rtos::SleepMs(500);
     }
 }
 
 void Consumer(void*) { 
-    std::cout << "[Consumer] Thread started\n";
+    Logger::Info("[Consumer] Thread started");
     for (int i = 1; i <= 10; ++i) {
         int value;
         if (queue.receive(value, CONSUMER_TIMEOUT_MS)) {
-            std::cout << "[Consumer] Received: " << value << std::endl;
+            Logger::Info("[Consumer] Received: %d", value);
             Rtos::SleepMs(500); // Simulate Processing
         } else {
-            std::cout << "[Consumer] Receive timed out!\n";
+            Logger::Warn("[Consumer] Receive timed out!");
         }
         Rtos::SleepMs(500);
     }
 }
 
 int main() {
+    Rtos::Task logger;
+    logger.Create("Logger", Logger::Run, nullptr);
+
     Rtos::Task producerTask;
     Rtos::Task consumerTask;
 
     producerTask.Create("Producer", Producer, nullptr);
     consumerTask.Create("Consumer", Consumer, nullptr);
 
-    std::cout << "[Main] Waiting for threads...\n";
+    Logger::Info("[Main] Waiting for threads...");
     producerTask.Join();
-    std::cout << "[Producer] Finished sending all items.\n";
+    Logger::Info("[Producer] Finished sending all items.");
     consumerTask.Join();
-    std::cout << "[Consumer] Finished processing all items.\n";
+    Logger::Info("[Consumer] Finished processing all items.");
 
-    std::cout << "[Main] Test complete.\n";
+    Logger::Info("[Main] Test complete.");
+    Logger::Flush();
     return 0;
 }
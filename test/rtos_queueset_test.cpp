@@ -0,0 +1,119 @@
+#include "os/rtos.hpp"
+#include "queues/topic.hpp"
+#include <iostream>
+
+// One consumer blocks on a set of four different queue types plus a
+// signal bit, fed by one producer each
+Rtos::Queue<long, 8> lockedQueue;
+Rtos::SpscQueue<long, 8> spscQueue;
+Rtos::MpmcQueue<long, 8> mpmcQueue;
+Bus::Topic<long, 8> topic;
+Rtos::QueueSet set;
+uint32_t stopBit = 0;
+
+constexpr long ITEMS_PER_PRODUCER = 20000;
+constexpr int TIMEOUT_MS = 1000;
+
+void LockedProducer(void*) {
+    for (long i = 1; i <= ITEMS_PER_PRODUCER; ++i) lockedQueue.send(i, TIMEOUT_MS);
+}
+
+void SpscProducer(void*) {
+    for (long i = 1; i <= ITEMS_PER_PRODUCER; ++i) spscQueue.send(i, TIMEOUT_MS);
+}
+
+void MpmcProducer(void*) {
+    for (long i = 1; i <= ITEMS_PER_PRODUCER; ++i) mpmcQueue.send(i, TIMEOUT_MS);
+}
+
+void TopicProducer(void*) {
+    for (long i = 1; i <= ITEMS_PER_PRODUCER; ++i) topic.publish(i, TIMEOUT_MS);
+}
+
+bool EventGroupTest() {
+    Rtos::EventGroup group;
+    bool ok = group.get() == 0;
+    ok = ok && group.set(0x5) == 0x5 && group.clear(0x1) == 0x5 && group.get() == 0x4;
+
+    // Any vs all, with and without clearing
+    ok = ok && (group.wait(0x6, false, false, 0) & 0x4) && group.get() == 0x4;
+    ok = ok && !((group.wait(0x6, true, true, 0) & 0x6) == 0x6);        // 0x2 missing
+    ok = ok && !((group.wait(0x6, true, true, 20) & 0x6) == 0x6);       // ... times out
+    group.set(0x2);
+    ok = ok && (group.wait(0x6, true, true, 0) & 0x6) == 0x6 && group.get() == 0;
+    ok = ok && (group.set(0xFF000001) == 0x1);                          // Only 24 bits usable
+    std::cout << "[Main] Event group: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Every task parked on an event group wakes on one set()
+Rtos::EventGroup broadcast;
+std::atomic<int> woken{0};
+
+void BroadcastWaiter(void*) {
+    if (broadcast.wait(0x1, false, false, TIMEOUT_MS) & 0x1) woken++;
+}
+
+bool BroadcastTest() {
+    Rtos::Task waiters[3];
+    for (auto& w : waiters) w.Create("Waiter", BroadcastWaiter, nullptr);
+    Rtos::SleepMs(50);
+    broadcast.set(0x1);
+    for (auto& w : waiters) w.Join();
+    bool ok = woken.load() == 3;
+    std::cout << "[Main] Broadcast: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = EventGroupTest();
+    ok = BroadcastTest() && ok;
+
+    Bus::Subscriber<long, 8> sub(topic, Bus::Overflow::BACKPRESSURE);
+    const uint32_t lockedBit = set.add(lockedQueue);
+    const uint32_t spscBit = set.add(spscQueue);
+    const uint32_t mpmcBit = set.add(mpmcQueue);
+    const uint32_t topicBit = set.add(sub);
+    stopBit = set.add_signal();
+    ok = ok && lockedBit && spscBit && mpmcBit && topicBit && stopBit;
+    ok = ok && set.wait(0) == (lockedBit | spscBit | mpmcBit | topicBit);   // Added as maybe-ready
+    ok = ok && set.wait(10) == 0;
+
+    Rtos::Task producers[4];
+    producers[0].Create("Locked", LockedProducer, nullptr);
+    producers[1].Create("Spsc", SpscProducer, nullptr);
+    producers[2].Create("Mpmc", MpmcProducer, nullptr);
+    producers[3].Create("Topic", TopicProducer, nullptr);
+
+    // Single blocking call per wake-up, no polling of the individual queues
+    long counts[4] = {}, sums[4] = {};
+    long wakeups = 0;
+    const long total = 4 * ITEMS_PER_PRODUCER;
+    long received = 0;
+    bool stopped = false;
+    while (!stopped) {
+        const uint32_t ready = set.wait(TIMEOUT_MS);
+        if (ready == 0) {
+            std::cout << "[Main] Set wait timed out after " << received << " items\n";
+            ok = false;
+            break;
+        }
+        wakeups++;
+        long v;
+        if (ready & lockedBit) while (lockedQueue.try_receive(v)) { counts[0]++; sums[0] += v; }
+        if (ready & spscBit)   while (spscQueue.try_receive(v))   { counts[1]++; sums[1] += v; }
+        if (ready & mpmcBit)   while (mpmcQueue.try_receive(v))   { counts[2]++; sums[2] += v; }
+        if (ready & topicBit)  while (sub.try_receive(v))         { counts[3]++; sums[3] += v; }
+        received = counts[0] + counts[1] + counts[2] + counts[3];
+        if (received == total) set.signal(stopBit);
+        if (ready & stopBit) stopped = true;
+    }
+    for (auto& p : producers) p.Join();
+
+    const long expectedSum = ITEMS_PER_PRODUCER * (ITEMS_PER_PRODUCER + 1) / 2;
+    for (int i = 0; i < 4; ++i) ok = ok && counts[i] == ITEMS_PER_PRODUCER && sums[i] == expectedSum;
+
+    std::cout << "[Main] Received " << received << " items in " << wakeups << " wake-ups\n";
+    std::cout << "[Main] Queue Set Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
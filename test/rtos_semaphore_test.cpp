@@ -1,35 +1,38 @@
 #include "os/rtos.hpp"
-#include <iostream>
+#include "apps/Logger/logger.hpp"
 
 
 Rtos::BinarySemaphore sem;
 int timeout_ms = 2000;
 
 void Consumer(void*) {
-    std::cout << "[Consumer] Waiting for semaphore...\n";
+    Logger::Info("[Consumer] Waiting for semaphore...");
     // sem.take();  // Should block until Producer gives
     // Non-blocking attempt
     if(sem.try_take()){
-        std::cout << "[Consumer] Semaphore acquired immediately!\n";
+        Logger::Info("[Consumer] Semaphore acquired immediately!");
     } else {
-        std::cout << "[Consumer] Semaphore not available, waiting...\n";
+        Logger::Info("[Consumer] Semaphore not available, waiting...");
         if (sem.take(timeout_ms)) {
-            std::cout << "[Consumer] Acquired\n";
+            Logger::Info("[Consumer] Acquired");
         } else {
-            std::cout << "[Consumer] Timed out\n";
+            Logger::Warn("[Consumer] Timed out");
         }
     } 
 }
 
 void Producer(void*) {
-    std::cout << "[Producer] Sleeping for 2 seconds before giving semaphore...\n";
+    Logger::Info("[Producer] Sleeping for 2 seconds before giving semaphore...");
     Rtos::SleepMs(1000);  // Simulate delay
-    std::cout << "[Producer] Giving semaphore now.\n";
+    Logger::Info("[Producer] Giving semaphore now.");
     sem.give();
 }
 
 int main() {
-    std::cout << "[Main] Starting Binary Semaphore Test\n";
+    Rtos::Task logger;
+    logger.Create("Logger", Logger::Run, nullptr);
+
+    Logger::Info("[Main] Starting Binary Semaphore Test");
 
     Rtos::Task consumerTask;
     Rtos::Task producerTask;
@@ -40,6 +43,7 @@ int main() {
     consumerTask.Join();
     producerTask.Join();
 
-    std::cout << "[Main] Binary Semaphore Test complete.\n";
+    Logger::Info("[Main] Binary Semaphore Test complete.");
+    Logger::Flush();
     return 0;
 }
@@ -0,0 +1,57 @@
+#include "os/rtos.hpp"
+#include "apps/Logger/logger.hpp"
+#include <iostream>
+#include <chrono>
+
+// Small queue so both the "full" and "empty" sleep paths get exercised
+Rtos::SpscQueue<int, 4> queue;
+constexpr int NUM_ITEMS = 200000;
+constexpr int TIMEOUT_MS = 1000;
+
+int errors = 0;
+
+void Producer(void*) {
+    for (int i = 1; i <= NUM_ITEMS; ++i) {
+        if (!queue.send(i, TIMEOUT_MS)) {
+            Logger::Error("[Producer] Send timed out at %d", i);
+            return;
+        }
+        if (i % 50000 == 0) Rtos::SleepMs(50); // Let the consumer go to sleep
+    }
+}
+
+void Consumer(void*) {
+    for (int expected = 1; expected <= NUM_ITEMS; ++expected) {
+        int value;
+        if (!queue.receive(value, TIMEOUT_MS)) {
+            Logger::Error("[Consumer] Receive timed out at %d", expected);
+            errors++;
+            return;
+        }
+        if (value != expected) errors++;  // Must arrive in order
+    }
+}
+
+int main() {
+    int value = 0;
+    std::cout << "[Main] try_receive on empty queue: "
+              << (queue.try_receive(value) ? "got item (FAIL)" : "empty (OK)") << "\n";
+    std::cout << "[Main] receive with 100 ms timeout: "
+              << (queue.receive(value, 100) ? "got item (FAIL)" : "timed out (OK)") << "\n";
+
+    Rtos::Task producerTask;
+    Rtos::Task consumerTask;
+
+    auto start = std::chrono::steady_clock::now();
+    consumerTask.Create("Consumer", Consumer, nullptr);
+    producerTask.Create("Producer", Producer, nullptr);
+    producerTask.Join();
+    consumerTask.Join();
+    Logger::Flush();   // Task-side errors before the summary
+    auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    std::cout << "[Main] Transferred " << NUM_ITEMS << " items in " << elapsed
+              << " s, ordering errors: " << errors << "\n";
+    std::cout << "[Main] SPSC Queue Test " << (errors == 0 ? "passed" : "FAILED") << ".\n";
+    return errors == 0 ? 0 : 1;
+}
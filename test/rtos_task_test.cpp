@@ -1,26 +1,26 @@
 // This is a test file for the RTOS Task implementation.
-#include <iostream>
-#include <cstdio>
 #include "os/rtos.hpp"
+#include "apps/Logger/logger.hpp"
 
-Rtos::Task t1, t2;
+Rtos::Task logger, t1, t2;
 
 void task1(void* arg) {
     while (true) {
-        printf("Hello from Task 1\n");
+        Logger::Info("Hello from Task 1");
         Rtos::SleepMs(1000); // 1 second
     }
 }
 
 void task2(void* arg) {
     while (true) {
-        printf("Hello from Task 2\n");
+        Logger::Info("Hello from Task 2");
         Rtos::SleepMs(1500); // 1.5 seconds
     }
 }
 
 
 int main() {
+    logger.Create("Logger", Logger::Run, nullptr);
     t1.Create("Task1", task1, nullptr);
     t2.Create("Task2", task2, nullptr);
 
@@ -0,0 +1,86 @@
+#include "os/rtos.hpp"
+#include <pthread.h>
+#include <sched.h>
+#include <atomic>
+#include <iostream>
+#include <string>
+
+// Reports the scheduling a task actually got from its TaskConfig
+struct Report {
+    int policy;
+    int priority;
+    int cpuCount;
+    int onCore;
+    char name[16];
+    size_t stackSize;
+};
+
+Report fifoReport, defaultReport;
+
+void Inspect(void* arg) {
+    auto* r = static_cast<Report*>(arg);
+    pthread_t self = pthread_self();
+
+    sched_param param{};
+    pthread_getschedparam(self, &r->policy, &param);
+    r->priority = param.sched_priority;
+
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    pthread_getaffinity_np(self, sizeof(cpus), &cpus);
+    r->cpuCount = CPU_COUNT(&cpus);
+    r->onCore = CPU_ISSET(0, &cpus);
+
+    pthread_getname_np(self, r->name, sizeof(r->name));
+
+    pthread_attr_t attr;
+    pthread_getattr_np(self, &attr);
+    pthread_attr_getstacksize(&attr, &r->stackSize);
+    pthread_attr_destroy(&attr);
+}
+
+void Print(const char* label, const Report& r) {
+    std::cout << "[" << label << "] name '" << r.name << "', policy "
+              << (r.policy == SCHED_FIFO ? "SCHED_FIFO" : "SCHED_OTHER")
+              << ", priority " << r.priority << ", cpus " << r.cpuCount
+              << ", stack " << r.stackSize / 1024 << " KB\n";
+}
+
+std::atomic<int> shortLivedRuns{0};
+void CountRun(void*) { shortLivedRuns++; }
+
+int main() {
+    Rtos::TaskConfig config;
+    config.priority = 80;
+    config.stackSize = 256 * 1024;
+    config.core = 0;
+
+    Rtos::Task fifoTask, defaultTask;
+    fifoTask.Create("EstimatorWithALongName", Inspect, &fifoReport, config);
+    fifoTask.Join();
+    defaultTask.Create("Default", Inspect, &defaultReport);
+    defaultTask.Join();
+
+    Print("Configured", fifoReport);
+    Print("Default", defaultReport);
+
+    bool ok = true;
+    // Real-time policy needs privileges; without them the task must still run
+    if (fifoReport.policy == SCHED_FIFO) ok = ok && fifoReport.priority == 80;
+    else std::cout << "[Main] No real-time privileges, fallback used\n";
+    ok = ok && fifoReport.cpuCount == 1 && fifoReport.onCore;
+    ok = ok && fifoReport.stackSize >= config.stackSize;
+    ok = ok && std::string(fifoReport.name) == "EstimatorWithAL";
+    ok = ok && std::string(defaultReport.name) == "Default";
+
+    // A Task may be destroyed as soon as Create returns; the thread runs on
+    for (int i = 0; i < 200; ++i) {
+        Rtos::Task shortLived;
+        shortLived.Create("ShortLived", CountRun, nullptr);
+    }
+    for (int i = 0; i < 100 && shortLivedRuns.load() < 200; ++i) Rtos::SleepMs(10);
+    ok = ok && shortLivedRuns.load() == 200;
+
+    std::cout << "[Main] Task Config Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
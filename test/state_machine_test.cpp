@@ -0,0 +1,37 @@
+#include "apps/StateMachine/state_machine.hpp"
+#include <iostream>
+
+static bool Expect(bool cond, const char* what) {
+    if (!cond) std::cout << "[Main] FAIL: " << what << "\n";
+    return cond;
+}
+
+int main() {
+    using SM = StateMachine;
+    bool ok = true;
+
+    // Nothing but ARM is accepted while IDLE
+    ok &= Expect(!SM::Post(SM::CMD_TX_ON), "TX_ON rejected while IDLE");
+    ok &= Expect(!SM::Post(SM::LAUNCH), "LAUNCH ignored while IDLE");
+    ok &= Expect(!SM::IsArmed() && !SM::IsTxOn(), "IDLE flags");
+
+    // Arm, then disarm is refused while transmitting
+    ok &= Expect(SM::Post(SM::CMD_ARM) && SM::GetState() == SM::ARMED, "ARM");
+    ok &= Expect(SM::Post(SM::CMD_TX_ON) && SM::IsTxOn(), "TX_ON once armed");
+    ok &= Expect(!SM::Post(SM::CMD_DISARM) && SM::GetState() == SM::ARMED, "DISARM guarded by TX");
+    ok &= Expect(SM::Post(SM::CMD_TX_OFF) && !SM::IsTxOn(), "TX_OFF");
+    ok &= Expect(SM::Post(SM::CMD_DISARM) && SM::GetState() == SM::IDLE, "DISARM");
+
+    // Full mission
+    ok &= Expect(SM::Post(SM::CMD_ARM), "re-ARM");
+    ok &= Expect(!SM::Post(SM::APOGEE), "APOGEE before LAUNCH ignored");
+    ok &= Expect(SM::Post(SM::LAUNCH) && SM::GetState() == SM::ASCENT, "LAUNCH");
+    ok &= Expect(!SM::Post(SM::CMD_DISARM), "no DISARM in flight");
+    ok &= Expect(SM::Post(SM::APOGEE) && SM::GetState() == SM::DESCENT, "APOGEE");
+    ok &= Expect(SM::Post(SM::LANDING) && SM::GetState() == SM::LANDED, "LANDING");
+    ok &= Expect(SM::IsTxOn(), "beacon on after landing");
+    ok &= Expect(!SM::Post(SM::LAUNCH) && SM::IsArmed(), "LANDED is final");
+
+    std::cout << "[Main] State Machine Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
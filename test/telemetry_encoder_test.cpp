@@ -0,0 +1,99 @@
+#include "apps/TelemetryManager/telemetry_encoder.hpp"
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+
+bool Expect(bool cond, const char* what) {
+    if (!cond) std::cout << "[Main] FAIL: " << what << "\n";
+    return cond;
+}
+
+// Independent bitwise CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF)
+static uint16_t ReferenceCrc(const uint8_t* p, size_t len) {
+    uint16_t crc = 0xFFFF;
+    for (size_t i = 0; i < len; ++i) {
+        crc ^= static_cast<uint16_t>(p[i] << 8);
+        for (int b = 0; b < 8; ++b) crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021) : static_cast<uint16_t>(crc << 1);
+    }
+    return crc;
+}
+
+static const msg::imu SAMPLE{1.0f, -2.0f, 0.5f, 0.0f, 0.25f, 100.0f, 0x12345678};
+
+static bool SameBytes(const uint8_t* got, const uint8_t* want, size_t len) {
+    if (std::memcmp(got, want, len) == 0) return true;
+    for (size_t i = 0; i < len; ++i) std::printf("%02X ", got[i]);
+    std::printf("\n");
+    return false;
+}
+
+// The exact bytes a ground decoder is written against
+bool GoldenFrameTest() {
+    static const uint8_t golden[] = {
+        0x1A, 0xCF, 0x01, 0x18, 0x00, 0x00, 0x78, 0x56, 0x34, 0x12,   // sync, type, len, seq, ms
+        0x00, 0x00, 0x80, 0x3F,                                       // ax  1.0
+        0x00, 0x00, 0x00, 0xC0,                                       // ay -2.0
+        0x00, 0x00, 0x00, 0x3F,                                       // az  0.5
+        0x00, 0x00, 0x00, 0x00,                                       // gx  0.0
+        0x00, 0x00, 0x80, 0x3E,                                       // gy  0.25
+        0x00, 0x00, 0xC8, 0x42,                                       // gz  100.0
+        0xCE, 0x34,                                                   // crc 0x34CE
+    };
+    uint8_t buf[64];
+    TelemetryEncoder enc(buf, sizeof(buf));
+    const size_t len = enc.Encode(SAMPLE);
+    bool ok = Expect(len == sizeof(golden) && enc.Size() == len, "frame length");
+    ok = Expect(len == sizeof(golden) && SameBytes(buf, golden, len), "golden bytes") && ok;
+
+    // CRC covers type..payload, not the sync bytes
+    const uint16_t crc = static_cast<uint16_t>(buf[len - 2] | buf[len - 1] << 8);
+    ok = Expect(crc == ReferenceCrc(buf + 2, len - 4), "crc over header and payload") && ok;
+    std::cout << "[Main] Golden frame: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// seq is shared by every frame type and wraps from 0xFFFF to 0
+bool SequenceWrapTest() {
+    uint8_t buf[64];
+    TelemetryEncoder enc(buf, sizeof(buf));
+    msg::cmd_ack ack{};
+    for (uint32_t i = 0; i < 0xFFFF; ++i) {
+        enc.Clear();
+        if (i % 2) enc.Encode(SAMPLE);
+        else enc.Encode(ack);
+    }
+    bool ok = Expect(enc.NextSeq() == 0xFFFF, "seq counts every frame");
+
+    enc.Clear();
+    size_t len = enc.Encode(SAMPLE);
+    ok = Expect(buf[4] == 0xFF && buf[5] == 0xFF, "seq 0xFFFF little-endian") && ok;
+    ok = Expect(buf[len - 2] == 0x8B && buf[len - 1] == 0x1E, "crc includes seq") && ok;
+
+    enc.Clear();
+    len = enc.Encode(SAMPLE);
+    ok = Expect(buf[4] == 0x00 && buf[5] == 0x00 && enc.NextSeq() == 1, "seq wraps to 0") && ok;
+    std::cout << "[Main] Sequence wrap: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Frames are appended back to back; one that does not fit is refused whole
+bool CapacityTest() {
+    uint8_t buf[80];
+    TelemetryEncoder enc(buf, sizeof(buf));
+    const size_t frameLen = TelemetryEncoder::HEADER_LEN + TelemetryEncoder::IMU_PAYLOAD_LEN + TelemetryEncoder::CRC_LEN;
+    bool ok = Expect(enc.Encode(SAMPLE) == frameLen && enc.Encode(SAMPLE) == frameLen, "two frames");
+    ok = Expect(buf[frameLen] == TelemetryEncoder::SYNC_0 && buf[frameLen + 4] == 0x01, "second frame after the first") && ok;
+    ok = Expect(enc.Encode(SAMPLE) == 0 && enc.Size() == 2 * frameLen && enc.NextSeq() == 2, "full buffer untouched") && ok;
+    std::cout << "[Main] Capacity: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = Expect(ReferenceCrc(reinterpret_cast<const uint8_t*>("123456789"), 9) == 0x29B1, "reference crc check value");
+    ok = GoldenFrameTest() && ok;
+    ok = SequenceWrapTest() && ok;
+    ok = CapacityTest() && ok;
+
+    std::cout << "[Main] Telemetry Encoder Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,223 @@
+#include "apps/TimerService/timer_service.hpp"
+#include "utils/timing_wheel.hpp"
+#include <atomic>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <vector>
+
+//== Wheel on its own, against exact expiry ticks ==//
+
+struct TestNode {
+    TimingWheel::Node node;   // First member: the node address is the TestNode address
+    uint64_t want;
+    uint64_t firedAt;
+    int fired;
+    bool removed;
+    uint32_t period;
+};
+
+bool WheelTest() {
+    std::mt19937_64 rng(42);
+    const uint64_t start = 1'000'003;   // Not aligned to any level
+    TimingWheel wheel(start);
+    std::vector<TestNode> nodes(3000);
+
+    // Delays from every level, plus some past the top one
+    const uint64_t ranges[] = {60, 4000, 260000, TimingWheel::MAX_DELAY, TimingWheel::MAX_DELAY * 3};
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        TestNode& n = nodes[i];
+        n = TestNode{};
+        const uint64_t delay = 1 + rng() % ranges[i % 5];
+        n.want = start + delay;
+        n.period = (i % 50 == 0) ? 1 + static_cast<uint32_t>(rng() % 5000) : 0;
+        wheel.Insert(n.node, n.want);
+    }
+    for (size_t i = 0; i < nodes.size(); i += 7) {
+        wheel.Remove(nodes[i].node);
+        nodes[i].removed = true;
+    }
+
+    bool ok = true;
+    uint64_t now = start;
+    const uint64_t end = start + TimingWheel::MAX_DELAY * 3 + 10;
+    while (now < end) {
+        // Mix of single ticks and long jumps
+        now += (rng() % 4 == 0) ? 1 + rng() % 3 : 1 + rng() % 200000;
+        if (now > end) now = end;
+        wheel.Advance(now, [&](TimingWheel::Node& node) {
+            TestNode& n = reinterpret_cast<TestNode&>(node);
+            if (wheel.Now() != n.want || n.removed) ok = false;
+            n.firedAt = wheel.Now();
+            n.fired++;
+            if (n.period && n.fired < 3) {
+                n.want += n.period;
+                wheel.Insert(n.node, n.want);
+            }
+        });
+    }
+
+    int fired = 0;
+    for (const TestNode& n : nodes) {
+        const int expected = n.removed ? 0 : (n.period ? 3 : 1);
+        if (n.fired != expected) ok = false;
+        fired += n.fired;
+    }
+    ok = ok && wheel.Empty() && wheel.NextEvent() == TimingWheel::NEVER;
+    std::cout << "[Main] Wheel: " << fired << " expiries " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+//== Service task ==//
+
+struct Counter {
+    std::atomic<int> count{0};
+    std::atomic<uint64_t> lastUs{0};
+};
+
+void Count(void* arg) {
+    auto* c = static_cast<Counter*>(arg);
+    c->lastUs.store(Rtos::NowUs());
+    c->count++;
+}
+
+bool OneShotTest() {
+    Counter c;
+    Timer t(Count, &c);
+    const uint64_t started = Rtos::NowUs();
+    TimerService::Start(t, 50);
+    bool ok = TimerService::IsActive(t);
+    Rtos::SleepMs(120);
+    const uint64_t latencyUs = c.lastUs.load() - started;
+    ok = ok && c.count.load() == 1 && !TimerService::IsActive(t);
+    ok = ok && latencyUs >= 50000 && latencyUs < 70000;
+    std::cout << "[Main] One-shot fired after " << latencyUs / 1000 << " ms: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool PeriodicAndStopTest() {
+    Counter periodic, stopped;
+    Timer p(Count, &periodic);
+    Timer s(Count, &stopped);
+    TimerService::Start(p, 10, 10);
+    TimerService::Start(s, 30);
+    Rtos::SleepMs(5);
+    bool ok = TimerService::Stop(s) && !TimerService::Stop(s);
+    Rtos::SleepMs(200);
+    TimerService::Stop(p);
+    const int n = periodic.count.load();
+    Rtos::SleepMs(30);
+    ok = ok && stopped.count.load() == 0 && n >= 17 && n <= 21 && periodic.count.load() == n;
+    std::cout << "[Main] Periodic fired " << n << " times in ~200 ms: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool QueueSetTest() {
+    Rtos::QueueSet set;
+    const uint32_t tick = set.add_signal();
+    Timer t(set, tick);
+    const uint64_t started = Rtos::NowUs();
+    TimerService::Start(t, 20);
+    const uint32_t ready = set.wait(1000);
+    const uint64_t waitedUs = Rtos::NowUs() - started;
+    bool ok = ready == tick && waitedUs >= 20000 && waitedUs < 40000;
+    std::cout << "[Main] Queue set signalled after " << waitedUs / 1000 << " ms: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// A callback that re-arms its own timer
+Timer* g_chain = nullptr;
+std::atomic<int> g_chainCount{0};
+void Chain(void*) {
+    if (++g_chainCount < 5) TimerService::Start(*g_chain, 2);
+}
+
+bool ManyTimersTest() {
+    constexpr int NUM = 500;
+    static Counter counters[NUM];
+    std::vector<Timer*> timers;
+    std::mt19937 rng(7);
+    for (int i = 0; i < NUM; ++i) {
+        timers.push_back(new Timer(Count, &counters[i]));
+        TimerService::Start(*timers.back(), 1 + rng() % 150);
+    }
+    Timer chain(Chain, nullptr);
+    g_chain = &chain;
+    TimerService::Start(chain, 1);
+
+    Rtos::SleepMs(250);
+    bool ok = g_chainCount.load() == 5;
+    for (auto& c : counters) ok = ok && c.count.load() == 1;
+    for (Timer* t : timers) delete t;
+    std::cout << "[Main] " << NUM << " timers on one task: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Timers that expired while the task was busy fire oldest first
+std::atomic<int> g_order[3];
+std::atomic<int> g_fired{0};
+void Record(void* arg) {
+    g_order[g_fired++].store(static_cast<int>(reinterpret_cast<intptr_t>(arg)));
+}
+void Block(void*) {
+    Rtos::SleepMs(60);   // Holds up the task so the timers below expire together
+}
+
+bool ExpiryOrderTest() {
+    Timer blocker(Block, nullptr);
+    Timer a(Record, reinterpret_cast<void*>(1));
+    Timer b(Record, reinterpret_cast<void*>(2));
+    Timer c(Record, reinterpret_cast<void*>(3));
+    TimerService::Start(blocker, 5);
+    TimerService::Start(c, 40);
+    TimerService::Start(b, 30);
+    TimerService::Start(a, 20);
+    Rtos::SleepMs(150);
+    bool ok = g_fired.load() == 3 && g_order[0].load() == 1 && g_order[1].load() == 2 && g_order[2].load() == 3;
+    std::cout << "[Main] Late expiries in order " << g_order[0].load() << g_order[1].load() << g_order[2].load()
+              << ": " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// A timer destroyed while armed, or while due, is stopped and never fires
+bool DestructorTest() {
+    Counter armed, due;
+    {
+        Timer t(Count, &armed);
+        TimerService::Start(t, 20);
+    }
+    {
+        // blocker then t expire while the task is held up; t is still on
+        // the due list, behind blocker, when it goes out of scope
+        Timer first(Block, nullptr), blocker(Block, nullptr), t(Count, &due);
+        TimerService::Start(first, 1);
+        Rtos::SleepMs(10);
+        TimerService::Start(blocker, 1);
+        TimerService::Start(t, 5);
+        Rtos::SleepMs(80);
+    }
+    Counter after;
+    Timer check(Count, &after);
+    TimerService::Start(check, 10);
+    Rtos::SleepMs(80);
+    bool ok = armed.count.load() == 0 && due.count.load() == 0 && after.count.load() == 1;
+    std::cout << "[Main] Destroyed timers stopped: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = WheelTest();
+
+    Rtos::Task service;
+    service.Create("TimerService", TimerService::Run, nullptr);
+
+    ok = OneShotTest() && ok;
+    ok = PeriodicAndStopTest() && ok;
+    ok = QueueSetTest() && ok;
+    ok = ManyTimersTest() && ok;
+    ok = ExpiryOrderTest() && ok;
+    ok = DestructorTest() && ok;
+
+    std::cout << "[Main] Timer Service Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
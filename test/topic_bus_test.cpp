@@ -0,0 +1,179 @@
+#include "queues/queues.hpp"
+#include <iostream>
+
+// Item tagged with its publisher so per-publisher order can be checked
+struct Tagged {
+    int publisher;
+    long value;
+};
+
+constexpr int NUM_PUBLISHERS = 3;
+constexpr int NUM_SUBSCRIBERS = 2;
+constexpr long ITEMS_PER_PUBLISHER = 50000;
+constexpr int TIMEOUT_MS = 1000;
+
+Bus::Topic<Tagged, 16> stressTopic;
+
+struct SubscriberData {
+    int id;
+    long count;
+    long sum;
+    bool inOrder;
+    Rtos::BinarySemaphore ready;
+};
+
+SubscriberData subscriberData[NUM_SUBSCRIBERS];
+
+void Publisher(void* arg) {
+    const int id = *static_cast<int*>(arg);
+    for (long i = 1; i <= ITEMS_PER_PUBLISHER; ++i) {
+        if (!stressTopic.publish(Tagged{id, i}, TIMEOUT_MS)) {
+            std::cout << "[Publisher " << id << "] Publish timed out\n";
+            return;
+        }
+    }
+}
+
+void Reader(void* arg) {
+    auto* data = static_cast<SubscriberData*>(arg);
+    Bus::Subscriber<Tagged, 16> sub(stressTopic, Bus::Overflow::BACKPRESSURE);
+    data->ready.give();
+
+    long last[NUM_PUBLISHERS] = {};
+    Tagged t;
+    // Stop once the publishers have gone quiet for a while
+    while (sub.receive(t, 200)) {
+        if (t.value != last[t.publisher] + 1) data->inOrder = false;
+        last[t.publisher] = t.value;
+        data->sum += t.value;
+        data->count++;
+    }
+}
+
+bool FanOutTest() {
+    Bus::Topic<int, 8> topic;
+    Bus::Subscriber<int, 8> a(topic), b(topic);
+    for (int i = 1; i <= 5; ++i) topic.try_publish(i);
+
+    // Every subscriber sees every message, in order
+    bool ok = a.pending() == 5 && b.pending() == 5;
+    int value;
+    for (int expected = 1; expected <= 5; ++expected) {
+        ok = ok && a.try_receive(value) && value == expected;
+        ok = ok && b.try_receive(value) && value == expected;
+    }
+    ok = ok && !a.try_receive(value) && !b.try_receive(value);
+
+    // A late subscriber starts with the next message
+    Bus::Subscriber<int, 8> late(topic);
+    topic.try_publish(6);
+    ok = ok && late.try_receive(value) && value == 6 && !late.try_receive(value);
+    std::cout << "[Main] Fan-out: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool DropOldestTest() {
+    Bus::Topic<int, 8> topic;
+    Bus::Subscriber<int, 8> sub(topic);
+    for (int i = 1; i <= 20; ++i) topic.try_publish(i);
+
+    // Lapped: the subscriber resumes near the oldest message still held
+    int value, previous = 0, count = 0;
+    bool ok = true;
+    while (sub.try_receive(value)) {
+        ok = ok && value > previous;
+        previous = value;
+        count++;
+    }
+    ok = ok && previous == 20 && count + static_cast<int>(sub.lost()) == 20 && sub.lost() > 0;
+    std::cout << "[Main] Drop oldest: " << (ok ? "OK" : "FAIL") << " (lost " << sub.lost() << ")\n";
+    return ok;
+}
+
+bool LatestTest() {
+    Bus::Topic<int, 8> topic;
+    Bus::Subscriber<int, 8> sub(topic, Bus::Overflow::LATEST);
+    for (int i = 1; i <= 5; ++i) topic.try_publish(i);
+
+    int value;
+    bool ok = sub.try_receive(value) && value == 5 && !sub.try_receive(value) && sub.lost() == 4;
+    std::cout << "[Main] Latest: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool BackpressureTest() {
+    Bus::Topic<int, 4, 2> topic;
+    bool ok = true;
+    {
+        Bus::Subscriber<int, 4, 2> gated(topic, Bus::Overflow::BACKPRESSURE);
+        Bus::Subscriber<int, 4, 2> lossy(topic);
+        Bus::Subscriber<int, 4, 2> noSlot(topic, Bus::Overflow::BACKPRESSURE);
+        ok = ok && gated.attached() && lossy.attached() && !noSlot.attached();  // Out of reader slots
+
+        for (int i = 1; i <= 4; ++i) ok = ok && topic.try_publish(i);
+        ok = ok && !topic.try_publish(5);        // Gated subscriber is a full ring behind
+        ok = ok && !topic.publish(5, 10);        // ... and stays there
+
+        int value;
+        ok = ok && gated.try_receive(value) && value == 1;
+        ok = ok && topic.try_publish(5) && !topic.try_publish(6);
+        for (int expected = 2; expected <= 5; ++expected) {
+            ok = ok && gated.try_receive(value) && value == expected;
+        }
+        ok = ok && lossy.try_receive(value) && value == 3 && lossy.lost() == 2;   // Lapped, lossless only for gated
+    }
+    // Gate released with the subscriber
+    for (int i = 0; i < 10; ++i) ok = ok && topic.try_publish(i);
+    std::cout << "[Main] Backpressure: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool TypedTopicTest() {
+    Bus::Subscription<Topics::CMD> cmds(Bus::Overflow::BACKPRESSURE);
+    msg::cmd c{msg::cmd::ARM, 7, 1234};
+    msg::cmd out{};
+    bool ok = Bus::Publish<Topics::CMD>(c) && cmds.try_receive(out);
+    ok = ok && out.type == msg::cmd::ARM && out.arg == 7 && out.ms == 1234;
+    std::cout << "[Main] Typed topic: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+int main() {
+    bool ok = FanOutTest();
+    ok = DropOldestTest() && ok;
+    ok = LatestTest() && ok;
+    ok = BackpressureTest() && ok;
+    ok = TypedTopicTest() && ok;
+
+    // Several publishers, every subscriber lossless
+    Rtos::Task publishers[NUM_PUBLISHERS];
+    Rtos::Task readers[NUM_SUBSCRIBERS];
+    int ids[NUM_PUBLISHERS];
+
+    for (int i = 0; i < NUM_SUBSCRIBERS; ++i) {
+        subscriberData[i].id = i + 1;
+        subscriberData[i].count = subscriberData[i].sum = 0;
+        subscriberData[i].inOrder = true;
+        readers[i].Create("Reader", Reader, &subscriberData[i]);
+        subscriberData[i].ready.take();   // Subscribed before anything is published
+    }
+    for (int i = 0; i < NUM_PUBLISHERS; ++i) {
+        ids[i] = i;
+        publishers[i].Create("Publisher", Publisher, &ids[i]);
+    }
+
+    for (auto& p : publishers) p.Join();
+    for (auto& r : readers) r.Join();
+
+    const long expectedCount = NUM_PUBLISHERS * ITEMS_PER_PUBLISHER;
+    const long expectedSum = NUM_PUBLISHERS * ITEMS_PER_PUBLISHER * (ITEMS_PER_PUBLISHER + 1) / 2;
+    for (auto& d : subscriberData) {
+        std::cout << "[Subscriber " << d.id << "] Received " << d.count << " items"
+                  << (d.inOrder ? "" : " OUT OF ORDER") << "\n";
+        ok = ok && d.count == expectedCount && d.sum == expectedSum && d.inOrder;
+    }
+
+    std::cout << "[Main] Published " << stressTopic.published() << "\n";
+    std::cout << "[Main] Topic Bus Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,131 @@
+#include "apps/Uplink/uplink_parser.hpp"
+#include "utils/crc16.hpp"
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <vector>
+
+// Collects decoded commands instead of publishing them on the CMD topic
+struct Collector {
+    std::vector<msg::cmd> cmds;
+};
+
+bool Collect(const msg::cmd& c, void* ctx) {
+    static_cast<Collector*>(ctx)->cmds.push_back(c);
+    return true;
+}
+
+bool CrcTest() {
+    const char* check = "123456789";
+    uint16_t crc = Crc16::Compute(reinterpret_cast<const uint8_t*>(check), 9);
+    bool ok = crc == 0x29B1;  // CRC-16/CCITT-FALSE check value
+    std::cout << "[Main] CRC-16 check value: " << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+// Random garbage, corrupted frames and random chunking around intact frames
+bool FuzzTest(uint32_t seed, int numFrames) {
+    std::mt19937 rng(seed);
+    std::vector<uint8_t> stream;
+    std::vector<msg::cmd> expected;
+
+    for (int i = 0; i < numFrames; ++i) {
+        msg::cmd c{};
+        c.type = static_cast<msg::cmd::Type>(rng() % msg::cmd::NUM_TYPES);
+        c.arg = static_cast<int32_t>(rng());
+
+        uint8_t frame[UplinkParser::CMD_FRAME_LEN];
+        size_t len = UplinkParser::Encode(c, frame);
+
+        switch (rng() % 6) {
+            case 0: {  // Garbage before the frame, sync bytes included
+                size_t n = rng() % 20;
+                for (size_t k = 0; k < n; ++k) {
+                    uint8_t b = rng() % 4 == 0 ? UplinkParser::SYNC_0 : static_cast<uint8_t>(rng());
+                    stream.push_back(b);
+                }
+                break;
+            }
+            case 1: {  // Corrupt one bit of another frame in front of this one
+                uint8_t bad[UplinkParser::CMD_FRAME_LEN];
+                UplinkParser::Encode(c, bad);
+                bad[2 + rng() % (len - 2)] ^= static_cast<uint8_t>(1u << (rng() % 8));
+                stream.insert(stream.end(), bad, bad + len);
+                break;
+            }
+            case 2: {  // Truncated frame: a real frame starts inside it
+                stream.insert(stream.end(), frame, frame + 2 + rng() % (len - 2));
+                break;
+            }
+            default:
+                break;
+        }
+        stream.insert(stream.end(), frame, frame + len);
+        expected.push_back(c);
+    }
+
+    Collector out;
+    UplinkParser parser(Collect, &out);
+    size_t pos = 0;
+    while (pos < stream.size()) {
+        size_t chunk = std::min<size_t>(1 + rng() % 64, stream.size() - pos);
+        parser.Feed(stream.data() + pos, chunk);
+        pos += chunk;
+    }
+
+    size_t matched = 0;
+    for (size_t i = 0, j = 0; i < expected.size() && j < out.cmds.size(); ++j) {
+        if (out.cmds[j].type == expected[i].type && out.cmds[j].arg == expected[i].arg) {
+            ++matched;
+            ++i;
+        }
+    }
+    const auto& st = parser.GetStats();
+    bool ok = matched == expected.size() && out.cmds.size() == expected.size();
+    std::cout << "[Fuzz seed " << seed << "] " << stream.size() << " bytes, " << matched << "/"
+              << expected.size() << " frames, crc errors " << st.crcErrors << ", len errors "
+              << st.lengthErrors << ", skipped " << st.skippedBytes << ": "
+              << (ok ? "OK" : "FAIL") << "\n";
+    return ok;
+}
+
+bool ThroughputTest() {
+    constexpr int NUM_FRAMES = 200000;
+    std::vector<uint8_t> stream;
+    stream.reserve(NUM_FRAMES * UplinkParser::CMD_FRAME_LEN);
+    for (int i = 0; i < NUM_FRAMES; ++i) {
+        msg::cmd c{};
+        c.type = msg::cmd::NOP;
+        c.arg = i;
+        uint8_t frame[UplinkParser::CMD_FRAME_LEN];
+        size_t len = UplinkParser::Encode(c, frame);
+        stream.insert(stream.end(), frame, frame + len);
+    }
+
+    size_t decoded = 0;
+    UplinkParser parser([](const msg::cmd&, void* ctx) {
+        ++*static_cast<size_t*>(ctx);
+        return true;
+    }, &decoded);
+
+    auto start = std::chrono::steady_clock::now();
+    parser.Feed(stream.data(), stream.size());
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    double bytesPerSec = stream.size() / secs;
+    double uartBytesPerSec = 115200.0 / 10.0;  // 8N1
+    std::cout << "[Throughput] " << bytesPerSec / 1e6 << " MB/s, " << secs * 1e9 / stream.size()
+              << " ns/byte, " << bytesPerSec / uartBytesPerSec << "x a 115200 baud link\n";
+    return decoded == NUM_FRAMES;
+}
+
+int main() {
+    bool ok = CrcTest();
+    for (uint32_t seed = 1; seed <= 5; ++seed) {
+        ok &= FuzzTest(seed, 5000);
+    }
+    ok &= ThroughputTest();
+    std::cout << "[Main] Uplink Parser Test " << (ok ? "passed" : "FAILED") << ".\n";
+    return ok ? 0 : 1;
+}
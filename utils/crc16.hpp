@@ -0,0 +1,44 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF, no reflection, no xorout)
+//
+// Used on the uplink and downlink framing. Table-driven, one lookup per
+// byte; the table is built at compile time so it lives in flash on the MCU.
+namespace Crc16 {
+
+constexpr uint16_t INIT = 0xFFFF;
+
+namespace detail {
+constexpr std::array<uint16_t, 256> MakeTable() {
+    std::array<uint16_t, 256> table{};
+    for (uint16_t i = 0; i < 256; ++i) {
+        uint16_t crc = static_cast<uint16_t>(i << 8);
+        for (int bit = 0; bit < 8; ++bit) {
+            crc = (crc & 0x8000) ? static_cast<uint16_t>((crc << 1) ^ 0x1021)
+                                 : static_cast<uint16_t>(crc << 1);
+        }
+        table[i] = crc;
+    }
+    return table;
+}
+
+constexpr std::array<uint16_t, 256> TABLE = MakeTable();
+} // namespace detail
+
+// Folds one byte into a running CRC
+inline uint16_t Update(uint16_t crc, uint8_t byte) {
+    return static_cast<uint16_t>((crc << 8) ^ detail::TABLE[((crc >> 8) ^ byte) & 0xFF]);
+}
+
+// CRC of a buffer, optionally continuing from a previous CRC
+inline uint16_t Compute(const uint8_t* data, size_t len, uint16_t crc = INIT) {
+    for (size_t i = 0; i < len; ++i) {
+        crc = Update(crc, data[i]);
+    }
+    return crc;
+}
+
+} // namespace Crc16
@@ -0,0 +1,154 @@
+#pragma once
+#include <cstddef>
+
+// Fixed-size matrices for the on-board filters
+//
+// Dimensions are template parameters, storage is an inline row-major
+// array: no heap, and every loop has a compile-time trip count so the
+// compiler can fully unroll the small sizes used in flight code. All
+// operations are constexpr, which lets shapes and identities be checked
+// with static_assert.
+
+#if defined(__GNUC__) && !defined(__clang__)
+#define LINALG_UNROLL _Pragma("GCC unroll 16")
+#elif defined(__clang__)
+#define LINALG_UNROLL _Pragma("unroll")
+#else
+#define LINALG_UNROLL
+#endif
+
+namespace Linalg {
+
+template <size_t R, size_t C>
+struct Matrix {
+    static constexpr size_t ROWS = R;
+    static constexpr size_t COLS = C;
+
+    float m[R][C];
+
+    constexpr float& operator()(size_t r, size_t c) { return m[r][c]; }
+    constexpr const float& operator()(size_t r, size_t c) const { return m[r][c]; }
+
+    // Vector-style access for single-column matrices
+    constexpr float& operator[](size_t i) { static_assert(C == 1, "column vectors only"); return m[i][0]; }
+    constexpr const float& operator[](size_t i) const { static_assert(C == 1, "column vectors only"); return m[i][0]; }
+
+    static constexpr Matrix Zero() {
+        Matrix z{};
+        return z;
+    }
+
+    static constexpr Matrix Identity() {
+        static_assert(R == C, "identity must be square");
+        Matrix z{};
+        LINALG_UNROLL
+        for (size_t i = 0; i < R; ++i) z.m[i][i] = 1.0f;
+        return z;
+    }
+
+    constexpr Matrix& operator+=(const Matrix& o) {
+        LINALG_UNROLL
+        for (size_t r = 0; r < R; ++r)
+            LINALG_UNROLL
+            for (size_t c = 0; c < C; ++c) m[r][c] += o.m[r][c];
+        return *this;
+    }
+
+    constexpr Matrix& operator-=(const Matrix& o) {
+        LINALG_UNROLL
+        for (size_t r = 0; r < R; ++r)
+            LINALG_UNROLL
+            for (size_t c = 0; c < C; ++c) m[r][c] -= o.m[r][c];
+        return *this;
+    }
+
+    constexpr Matrix& operator*=(float s) {
+        LINALG_UNROLL
+        for (size_t r = 0; r < R; ++r)
+            LINALG_UNROLL
+            for (size_t c = 0; c < C; ++c) m[r][c] *= s;
+        return *this;
+    }
+};
+
+template <size_t N>
+using Vector = Matrix<N, 1>;
+
+template <size_t R, size_t C>
+constexpr Matrix<R, C> operator+(Matrix<R, C> a, const Matrix<R, C>& b) { return a += b; }
+
+template <size_t R, size_t C>
+constexpr Matrix<R, C> operator-(Matrix<R, C> a, const Matrix<R, C>& b) { return a -= b; }
+
+template <size_t R, size_t C>
+constexpr Matrix<R, C> operator*(Matrix<R, C> a, float s) { return a *= s; }
+
+template <size_t R, size_t K, size_t C>
+constexpr Matrix<R, C> operator*(const Matrix<R, K>& a, const Matrix<K, C>& b) {
+    Matrix<R, C> out{};
+    LINALG_UNROLL
+    for (size_t r = 0; r < R; ++r)
+        LINALG_UNROLL
+        for (size_t k = 0; k < K; ++k) {
+            const float ark = a.m[r][k];
+            LINALG_UNROLL
+            for (size_t c = 0; c < C; ++c) out.m[r][c] += ark * b.m[k][c];
+        }
+    return out;
+}
+
+template <size_t R, size_t C>
+constexpr Matrix<C, R> Transpose(const Matrix<R, C>& a) {
+    Matrix<C, R> out{};
+    LINALG_UNROLL
+    for (size_t r = 0; r < R; ++r)
+        LINALG_UNROLL
+        for (size_t c = 0; c < C; ++c) out.m[c][r] = a.m[r][c];
+    return out;
+}
+
+template <size_t N>
+constexpr float Dot(const Vector<N>& a, const Vector<N>& b) {
+    float s = 0.0f;
+    LINALG_UNROLL
+    for (size_t i = 0; i < N; ++i) s += a.m[i][0] * b.m[i][0];
+    return s;
+}
+
+//== Symmetric helpers ==//
+// Covariances are symmetric: compute the upper triangle only and mirror
+// it, which roughly halves the work and keeps P exactly symmetric.
+
+// Returns F * P * F^T for symmetric P
+template <size_t N>
+constexpr Matrix<N, N> Congruence(const Matrix<N, N>& F, const Matrix<N, N>& P) {
+    const Matrix<N, N> FP = F * P;
+    Matrix<N, N> out{};
+    LINALG_UNROLL
+    for (size_t r = 0; r < N; ++r)
+        LINALG_UNROLL
+        for (size_t c = r; c < N; ++c) {
+            float s = 0.0f;
+            LINALG_UNROLL
+            for (size_t k = 0; k < N; ++k) s += FP.m[r][k] * F.m[c][k];
+            out.m[r][c] = s;
+            out.m[c][r] = s;
+        }
+    return out;
+}
+
+// P -= s * v * v^T for symmetric P
+template <size_t N>
+constexpr void RankOneDowndate(Matrix<N, N>& P, const Vector<N>& v, float s) {
+    LINALG_UNROLL
+    for (size_t r = 0; r < N; ++r) {
+        const float svr = s * v.m[r][0];
+        LINALG_UNROLL
+        for (size_t c = r; c < N; ++c) {
+            P.m[r][c] -= svr * v.m[c][0];
+            P.m[c][r] = P.m[r][c];
+        }
+    }
+}
+
+} // namespace Linalg
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Fixed-length sliding windows over a sample stream
+//
+// Both windows keep their samples in an inline ring of N entries: no heap,
+// and each Push is O(1) (amortised for the min/max deques, where every
+// sample is inserted and removed at most once).
+
+// Running mean and variance over the last N samples. Uses the windowed
+// Welford update, so the result does not drift the way a raw sum of
+// squares does over a long flight.
+template <size_t N>
+class SlidingStats {
+    public:
+        static_assert(N > 0, "window must hold at least one sample");
+
+        void Push(float x) {
+            if (count_ < N) {
+                ring_[head_] = x;
+                head_ = (head_ + 1) % N;
+                count_++;
+                const float d = x - mean_;
+                mean_ += d / count_;
+                m2_ += d * (x - mean_);
+                return;
+            }
+            const float old = ring_[head_];
+            ring_[head_] = x;
+            head_ = (head_ + 1) % N;
+            const float oldMean = mean_;
+            mean_ += (x - old) / N;
+            m2_ += (x - old) * (x - mean_ + old - oldMean);
+            if (m2_ < 0.0f) m2_ = 0.0f;   // Rounding can push an exact zero below it
+        }
+
+        void Reset() { head_ = count_ = 0; mean_ = m2_ = 0.0f; }
+
+        bool Full() const { return count_ == N; }
+        size_t Count() const { return count_; }
+        float Mean() const { return mean_; }
+        float Variance() const { return count_ > 1 ? m2_ / (count_ - 1) : 0.0f; }
+
+    private:
+        float ring_[N];
+        size_t head_ = 0;
+        size_t count_ = 0;
+        float mean_ = 0.0f;
+        float m2_ = 0.0f;
+};
+
+// Minimum and maximum over the last N samples with monotonic deques: the
+// min deque holds increasing values, the max deque decreasing ones, each
+// tagged with its sample index so expired entries fall off the front.
+template <size_t N>
+class SlidingMinMax {
+    public:
+        static_assert(N > 0, "window must hold at least one sample");
+
+        void Push(float x) {
+            // Drop the sample leaving the window first, so a deque never holds more than N
+            if (index_ >= N) {
+                PopExpired(min_, index_ - N);
+                PopExpired(max_, index_ - N);
+            }
+            PushBack(min_, x, index_, [](float back, float v) { return back >= v; });
+            PushBack(max_, x, index_, [](float back, float v) { return back <= v; });
+            index_++;
+        }
+
+        void Reset() { min_ = Deque{}; max_ = Deque{}; index_ = 0; }
+
+        // Only valid after at least one Push
+        float Min() const { return min_.items[min_.head].value; }
+        float Max() const { return max_.items[max_.head].value; }
+        float Range() const { return Max() - Min(); }
+
+    private:
+        struct Entry { float value; uint32_t index; };
+        struct Deque {
+            Entry items[N];
+            size_t head = 0, size = 0;
+        };
+
+        template <typename Dominated>
+        static void PushBack(Deque& d, float x, uint32_t index, Dominated dominated) {
+            while (d.size > 0 && dominated(d.items[(d.head + d.size - 1) % N].value, x)) d.size--;
+            d.items[(d.head + d.size) % N] = Entry{x, index};
+            d.size++;
+        }
+
+        static void PopExpired(Deque& d, uint32_t expired) {
+            while (d.size > 0 && d.items[d.head].index == expired) {
+                d.head = (d.head + 1) % N;
+                d.size--;
+            }
+        }
+
+        Deque min_, max_;
+        uint32_t index_ = 0;
+};
@@ -0,0 +1,171 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+// Hierarchical timing wheel
+//
+// LEVELS wheels of 64 slots each; level l covers delays up to 64^(l+1)
+// ticks at a resolution of 64^l. A timer goes into the coarsest level its
+// delay needs and moves down one level ("cascades") when the level below
+// wraps around to its slot, so insert, remove and expire are all O(1).
+// Delays beyond the top level are parked in it and re-cascaded until due.
+//
+// Nodes are intrusive (kernel hlist style: next plus a pointer to whatever
+// points at us), so the wheel never allocates. A 64-bit occupancy mask per
+// level lets NextEvent() find the next tick with work in O(LEVELS), and
+// Advance() jumps straight between such ticks instead of stepping one by one.
+//
+// The wheel itself is not thread-safe and knows nothing about real time;
+// ticks are whatever unit the owner counts in.
+class TimingWheel {
+    public:
+        static constexpr int LEVELS = 4;
+        static constexpr int SLOT_BITS = 6;
+        static constexpr int SLOTS = 1 << SLOT_BITS;
+        static constexpr uint64_t MAX_DELAY = (1ull << (SLOT_BITS * LEVELS)) - 1;
+        static constexpr uint64_t NEVER = UINT64_MAX;
+
+        struct Node {
+            Node* next = nullptr;
+            Node** pprev = nullptr;   // Null while not on any list
+            uint64_t expires = 0;
+            uint8_t level = 0;
+            uint8_t slot = 0;
+        };
+
+        //-- Intrusive list helpers, also usable for lists kept by the owner --//
+        static void Push(Node*& head, Node& n) {
+            n.next = head;
+            if (head) head->pprev = &n.next;
+            head = &n;
+            n.pprev = &head;
+        }
+
+        // FIFO lists: tail points at the last node's next (or at head when
+        // empty). Whoever unlinks the last node must step tail back to its pprev.
+        static void Append(Node**& tail, Node& n) {
+            n.next = nullptr;
+            n.pprev = tail;
+            *tail = &n;
+            tail = &n.next;
+        }
+
+        static void Unlink(Node& n) {
+            *n.pprev = n.next;
+            if (n.next) n.next->pprev = n.pprev;
+            n.next = nullptr;
+            n.pprev = nullptr;
+        }
+
+        static bool Linked(const Node& n) { return n.pprev != nullptr; }
+
+        explicit TimingWheel(uint64_t now = 0) : now_(now) {}
+
+        TimingWheel(const TimingWheel&) = delete;
+        TimingWheel& operator=(const TimingWheel&) = delete;
+
+        // Ticks up to now have been processed; a timer for now or earlier
+        // fires on the next tick
+        uint64_t Now() const { return now_; }
+
+        void Insert(Node& n, uint64_t expires) {
+            n.expires = expires > now_ ? expires : now_ + 1;
+            Place(n);
+        }
+
+        void Remove(Node& n) {
+            if (!Linked(n)) return;
+            Unlink(n);
+            if (!slots_[n.level][n.slot]) occupied_[n.level] &= ~(1ull << n.slot);
+        }
+
+        bool Empty() const {
+            for (uint64_t mask : occupied_) {
+                if (mask) return false;
+            }
+            return true;
+        }
+
+        // First tick at which Advance has work to do (expire or cascade)
+        uint64_t NextEvent() const {
+            uint64_t best = NEVER;
+            for (int l = 0; l < LEVELS; ++l) {
+                if (!occupied_[l]) continue;
+                const int shift = l * SLOT_BITS;
+                const uint64_t current = (now_ >> shift) & (SLOTS - 1);
+                const uint64_t base = (now_ >> (shift + SLOT_BITS)) << (shift + SLOT_BITS);
+
+                // Slots past the current index are due this revolution, the rest next one
+                const uint64_t ahead = current == SLOTS - 1 ? 0 : occupied_[l] & (~0ull << (current + 1));
+                const uint64_t slot = ahead ? Lowest(ahead) : Lowest(occupied_[l]) + SLOTS;
+                const uint64_t tick = base + (slot << shift);
+                if (tick < best) best = tick;
+            }
+            return best;
+        }
+
+        // Processes every tick up to and including now. expire(Node&) gets
+        // each due node already unlinked, in expiry-tick order; it may
+        // insert the node again (periodic timers) or insert others.
+        template <typename Expire>
+        void Advance(uint64_t now, Expire expire) {
+            while (now_ < now) {
+                const uint64_t next = NextEvent();
+                if (next > now) {
+                    now_ = now;
+                    return;
+                }
+                now_ = next;
+
+                // Level l starts a new slot when all lower levels wrap. Cascade
+                // from the top down, so a timer can fall several levels at once.
+                int top = 0;
+                while (top + 1 < LEVELS && (now_ & ((1ull << ((top + 1) * SLOT_BITS)) - 1)) == 0) top++;
+                for (int l = top; l >= 1; --l) Cascade(l, (now_ >> (l * SLOT_BITS)) & (SLOTS - 1));
+
+                const int slot = static_cast<int>(now_ & (SLOTS - 1));
+                while (Node* n = slots_[0][slot]) {
+                    Remove(*n);
+                    expire(*n);
+                }
+            }
+        }
+
+    private:
+        static int Lowest(uint64_t mask) { return __builtin_ctzll(mask); }
+
+        void Place(Node& n) {
+            uint64_t delta = n.expires - now_;
+            uint64_t at = n.expires;
+            if (delta > MAX_DELAY) {
+                // Park at the far end of the top level; cascading brings it back
+                delta = MAX_DELAY;
+                at = now_ + MAX_DELAY;
+            }
+            int level = 0;
+            while (level + 1 < LEVELS && delta >= (1ull << ((level + 1) * SLOT_BITS))) level++;
+            const int slot = static_cast<int>((at >> (level * SLOT_BITS)) & (SLOTS - 1));
+            n.level = static_cast<uint8_t>(level);
+            n.slot = static_cast<uint8_t>(slot);
+            Push(slots_[level][slot], n);
+            occupied_[level] |= 1ull << slot;
+        }
+
+        // Re-files every node of one slot relative to now_
+        void Cascade(int level, uint64_t slot) {
+            Node* list = slots_[level][slot];
+            slots_[level][slot] = nullptr;
+            occupied_[level] &= ~(1ull << slot);
+            while (list) {
+                Node* n = list;
+                list = n->next;
+                n->next = nullptr;
+                n->pprev = nullptr;
+                Place(*n);
+            }
+        }
+
+        uint64_t now_;
+        uint64_t occupied_[LEVELS] = {};
+        Node* slots_[LEVELS][SLOTS] = {};
+};